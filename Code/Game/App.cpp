@@ -208,6 +208,8 @@ void App::DeleteAndCreateNewGame()
 }
 
 //----------------------------------------------------------------------------------------------------
+// Not baked into Data/Cache like the definitions: the blackboard fills itself from the root element and
+// its children, and has no way to hand its pairs back, so a cache could only guess at what it read
 void App::LoadGameConfig(char const* gameConfigXmlFilePath)
 {
     XmlDocument     gameConfigXml;
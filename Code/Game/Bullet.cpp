@@ -5,6 +5,8 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Bullet.hpp"
 
+#include <algorithm>
+
 #include "PlayerTank.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -91,26 +93,39 @@ void Bullet::UpdateBody(float const deltaSeconds)
 {
     m_velocity = Vec2::MakeFromPolarDegrees(m_orientationDegrees, m_moveSpeed);
 
-    Ray2            ray             = Ray2(m_position, m_velocity, 0.05f);
-    RaycastResult2D raycastResult2D = m_map->RaycastVsTiles(ray);
-
-    Vec2 const nextPosition = m_position + m_velocity * deltaSeconds;
+    // Sweep the whole frame's travel instead of probing ahead, so a fast bullet or a long frame can't carry
+    // it through a thin wall or an entity
+    float remainingDist = m_moveSpeed * deltaSeconds;
 
-    if (raycastResult2D.m_didImpact)
+    for (int bounce = 0; bounce < MAX_BOUNCES_PER_UPDATE && remainingDist > 0.f && m_health > 0; ++bounce)
     {
-        m_health--;
+        Ray2 const            ray          = Ray2(m_position, m_velocity.GetNormalized(), remainingDist);
+        RaycastResult2D const tileResult   = m_map->SweepDiscVsTiles(ray, m_physicsRadius);
+        RaycastResult2D const entityResult = m_map->SweepDiscVsEntities(ray, m_physicsRadius, m_faction);
+
+        if (entityResult.m_didImpact && (!tileResult.m_didImpact || entityResult.m_impactLength < tileResult.m_impactLength))
+        {
+            float stopDist = entityResult.m_impactLength + CONTACT_SKIN;
+
+            if (tileResult.m_didImpact) stopDist = std::min(stopDist, tileResult.m_impactLength);
+
+            m_position += ray.m_forwardNormal * stopDist;
+            return;
+        }
 
+        if (!tileResult.m_didImpact)
+        {
+            m_position += ray.m_forwardNormal * remainingDist;
+            return;
+        }
 
-        // IntVec2 const normalOfSurfaceToReflectOffOf = m_map->GetTileCoordsFromWorldPos(m_position) - m_map->GetTileCoordsFromWorldPos(nextPosition);
-        IntVec2 const normalOfSurfaceToReflectOffOf = IntVec2(raycastResult2D.m_impactNormal);
-        printf("(%f, %f)\n", raycastResult2D.m_impactNormal.x, raycastResult2D.m_impactNormal.y);
-        Vec2 const ofSurfaceToReflectOffOf(static_cast<float>(normalOfSurfaceToReflectOffOf.x), static_cast<float>(normalOfSurfaceToReflectOffOf.y));
-        Vec2 const reflectedVelocity = m_velocity.GetReflected(ofSurfaceToReflectOffOf.GetNormalized());
+        m_health--;
+        m_position = tileResult.m_impactPosition;
+        remainingDist -= tileResult.m_impactLength;
+
+        Vec2 const reflectedVelocity = m_velocity.GetReflected(tileResult.m_impactNormal);
         m_orientationDegrees         = Atan2Degrees(reflectedVelocity.y, reflectedVelocity.x);
-    }
-    else
-    {
-        m_position = nextPosition;
+        m_velocity                   = reflectedVelocity;
     }
 }
 
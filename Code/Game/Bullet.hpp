@@ -22,6 +22,11 @@ public:
 private:
     void UpdateBody(float deltaSeconds);
     void RenderBody() const;
-    
+
+    // Wall bounces resolved within one update; travel left after the last one is dropped. An entity hit stops
+    // the bullet CONTACT_SKIN past first contact, so the overlap pass in Map resolves it.
+    static constexpr int   MAX_BOUNCES_PER_UPDATE = 4;
+    static constexpr float CONTACT_SKIN           = 0.01f;
+
     Texture* m_BodyTexture = nullptr;
 };
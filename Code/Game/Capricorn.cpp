@@ -5,7 +5,6 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Capricorn.hpp"
 
-#include "Engine/Core/HeatMaps.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
@@ -33,26 +32,6 @@ Capricorn::Capricorn(Map* map, EntityType const type, EntityFaction const factio
     m_bodyTexture = g_resourceSubsystem->CreateOrGetTextureFromFile(LEO_BODY_IMG);
 }
 
-void Capricorn::DebugRenderTileIndex() const
-{
-
-    IntVec2 dimensions = m_map->GetMapDimension();
-
-    for (int tileY = 0; tileY < dimensions.y; ++tileY)
-    {
-        for (int tileX = 0; tileX < dimensions.x; ++tileX)
-        {
-            float const value = m_heatMap->GetValueAtCoords(tileX, tileY);
-
-            VertexList_PCU textVerts;
-            BitmapFont*    bitmapFont = g_resourceSubsystem->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont");
-            bitmapFont->AddVertsForText2D(textVerts, std::to_string(static_cast<int>(value)),Vec2((float) tileX, (float) tileY), 0.2f,  Rgba8::BLACK);
-            g_renderer->BindTexture(&bitmapFont->GetTexture());
-            g_renderer->DrawVertexArray(static_cast<int>(textVerts.size()), textVerts.data());
-        }
-    }
-}
-
 //----------------------------------------------------------------------------------------------------
 void Capricorn::Update(float const deltaSeconds)
 {
@@ -79,7 +58,6 @@ void Capricorn::Render() const
         return;
 
     RenderBody();
-    // DebugRenderTileIndex();
 }
 
 //----------------------------------------------------------------------------------------------------
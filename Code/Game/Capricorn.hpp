@@ -12,7 +12,6 @@ class Capricorn : public Entity
 {
 public:
     Capricorn(Map* map, EntityType type, EntityFaction faction);
-    void DebugRenderTileIndex() const;
 
     void Update(float deltaSeconds) override;
     void Render() const override;
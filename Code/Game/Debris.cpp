@@ -80,25 +80,27 @@ void Debris::UpdateBody(float const deltaSeconds)
 {
     m_velocity = Vec2::MakeFromPolarDegrees(m_orientationDegrees, m_moveSpeed);
 
-    Ray2 ray = Ray2(m_position, m_velocity,0.05f);
-RaycastResult2D raycastResult2D = m_map->RaycastVsTiles(ray);
-    
-    Vec2 const nextPosition = m_position + m_velocity * deltaSeconds;
+    // Sweep the whole frame's travel instead of probing ahead, so no speed or frame length tunnels a wall
+    float remainingDist = m_moveSpeed * deltaSeconds;
 
-    if (raycastResult2D.m_didImpact)
+    for (int bounce = 0; bounce < MAX_BOUNCES_PER_UPDATE && remainingDist > 0.f && m_health > 0; ++bounce)
     {
+        Ray2 const            ray        = Ray2(m_position, m_velocity.GetNormalized(), remainingDist);
+        RaycastResult2D const tileResult = m_map->SweepDiscVsTiles(ray, m_physicsRadius);
+
+        if (!tileResult.m_didImpact)
+        {
+            m_position += ray.m_forwardNormal * remainingDist;
+            return;
+        }
+
         m_health--;
+        m_position = tileResult.m_impactPosition;
+        remainingDist -= tileResult.m_impactLength;
 
-        // IntVec2 const normalOfSurfaceToReflectOffOf = m_map->GetTileCoordsFromWorldPos(m_position) - m_map->GetTileCoordsFromWorldPos(nextPosition);
-        IntVec2 const normalOfSurfaceToReflectOffOf = IntVec2(raycastResult2D.m_impactNormal);
-        // printf("(%f, %f)\n", raycastResult2D.m_impactNormal.x, raycastResult2D.m_impactNormal.y);
-        Vec2 const    ofSurfaceToReflectOffOf(static_cast<float>(normalOfSurfaceToReflectOffOf.x), static_cast<float>(normalOfSurfaceToReflectOffOf.y));
-        Vec2 const    reflectedVelocity = m_velocity.GetReflected(ofSurfaceToReflectOffOf.GetNormalized());
-        m_orientationDegrees            = Atan2Degrees(reflectedVelocity.y, reflectedVelocity.x);
-    }
-    else
-    {
-        m_position = nextPosition;
+        Vec2 const reflectedVelocity = m_velocity.GetReflected(tileResult.m_impactNormal);
+        m_orientationDegrees         = Atan2Degrees(reflectedVelocity.y, reflectedVelocity.x);
+        m_velocity                   = reflectedVelocity;
     }
 }
 
@@ -22,6 +22,9 @@ public:
 private:
     void UpdateBody(float deltaSeconds);
     void RenderBody() const;
-    
+
+    // Wall bounces resolved within one update; travel left after the last one is dropped
+    static constexpr int MAX_BOUNCES_PER_UPDATE = 4;
+
     Texture* m_BodyTexture = nullptr;
 };
@@ -0,0 +1,271 @@
+//----------------------------------------------------------------------------------------------------
+// DefinitionCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/DefinitionCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    constexpr uint32_t DEFINITION_CACHE_MAGIC = 0x43444C44;    // "DLDC"
+
+    struct DefinitionCacheHeader
+    {
+        uint32_t m_magic       = DEFINITION_CACHE_MAGIC;
+        uint32_t m_version     = DEFINITION_CACHE_VERSION;
+        uint64_t m_sourceHash  = 0;
+        uint64_t m_payloadSize = 0;
+    };
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t HashBytesFNV1a(unsigned char const* bytes, size_t const numBytes)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (size_t byteIndex = 0; byteIndex < numBytes; ++byteIndex)
+    {
+        hash ^= bytes[byteIndex];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The whole file in one fread
+bool ReadBinaryFile(char const* filePath, std::vector<unsigned char>& out_bytes)
+{
+    FILE* file = nullptr;
+
+    if (fopen_s(&file, filePath, "rb") != 0 || file == nullptr) return false;
+
+    fseek(file, 0, SEEK_END);
+    long const fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (fileSize < 0)
+    {
+        fclose(file);
+        return false;
+    }
+
+    out_bytes.resize(static_cast<size_t>(fileSize));
+
+    size_t const numBytesRead = fileSize > 0 ? fread(out_bytes.data(), 1, out_bytes.size(), file) : 0;
+
+    fclose(file);
+
+    return numBytesRead == out_bytes.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool HashFileContents(char const* filePath, uint64_t& out_hash)
+{
+    std::vector<unsigned char> bytes;
+
+    if (!ReadBinaryFile(filePath, bytes)) return false;
+
+    out_hash = HashBytesFNV1a(bytes.data(), bytes.size());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteByte(unsigned char const value)
+{
+    m_buffer.push_back(value);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteBool(bool const value)
+{
+    m_buffer.push_back(value ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteInt(int const value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteFloat(float const value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteString(String const& value)
+{
+    WriteInt(static_cast<int>(value.size()));
+    WriteBytes(value.data(), value.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteIntVec2(IntVec2 const& value)
+{
+    WriteInt(value.x);
+    WriteInt(value.y);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteRgba8(Rgba8 const& value)
+{
+    WriteByte(value.r);
+    WriteByte(value.g);
+    WriteByte(value.b);
+    WriteByte(value.a);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Failing to write the cache is not an error; the next launch just parses the XML again
+bool DefinitionCacheWriter::SaveToFile(char const* cacheFilePath, uint64_t const sourceHash) const
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(std::filesystem::path(cacheFilePath).parent_path(), errorCode);
+
+    FILE* file = nullptr;
+
+    if (fopen_s(&file, cacheFilePath, "wb") != 0 || file == nullptr)
+    {
+        printf("WARNING: failed to write definition cache \"%s\"\n", cacheFilePath);
+        return false;
+    }
+
+    DefinitionCacheHeader header;
+    header.m_sourceHash  = sourceHash;
+    header.m_payloadSize = m_buffer.size();
+
+    bool const didWrite = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(m_buffer.data(), 1, m_buffer.size(), file) == m_buffer.size();
+
+    fclose(file);
+
+    return didWrite;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DefinitionCacheWriter::WriteBytes(void const* data, size_t const numBytes)
+{
+    unsigned char const* bytes = static_cast<unsigned char const*>(data);
+
+    m_buffer.insert(m_buffer.end(), bytes, bytes + numBytes);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false (and leaves the reader invalid) for a missing, stale or truncated cache
+bool DefinitionCacheReader::LoadFromFile(char const* cacheFilePath, uint64_t const sourceHash)
+{
+    m_isValid    = false;
+    m_readOffset = 0;
+
+    if (!ReadBinaryFile(cacheFilePath, m_buffer)) return false;
+
+    DefinitionCacheHeader header;
+
+    if (m_buffer.size() < sizeof(header)) return false;
+
+    memcpy(&header, m_buffer.data(), sizeof(header));
+
+    if (header.m_magic != DEFINITION_CACHE_MAGIC ||
+        header.m_version != DEFINITION_CACHE_VERSION ||
+        header.m_sourceHash != sourceHash ||
+        header.m_payloadSize != m_buffer.size() - sizeof(header))
+    {
+        return false;
+    }
+
+    m_readOffset = sizeof(header);
+    m_isValid    = true;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned char DefinitionCacheReader::ReadByte()
+{
+    unsigned char value = 0;
+    ReadBytes(&value, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool DefinitionCacheReader::ReadBool()
+{
+    return ReadByte() != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DefinitionCacheReader::ReadInt()
+{
+    int value = 0;
+    ReadBytes(&value, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+float DefinitionCacheReader::ReadFloat()
+{
+    float value = 0.f;
+    ReadBytes(&value, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+String DefinitionCacheReader::ReadString()
+{
+    int const length = ReadInt();
+
+    if (length < 0 || static_cast<size_t>(length) > m_buffer.size() - m_readOffset)
+    {
+        m_isValid = false;
+        return String();
+    }
+
+    String value(reinterpret_cast<char const*>(&m_buffer[m_readOffset]), static_cast<size_t>(length));
+    m_readOffset += static_cast<size_t>(length);
+
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 DefinitionCacheReader::ReadIntVec2()
+{
+    int const x = ReadInt();
+    int const y = ReadInt();
+
+    return IntVec2(x, y);
+}
+
+//----------------------------------------------------------------------------------------------------
+Rgba8 DefinitionCacheReader::ReadRgba8()
+{
+    unsigned char const r = ReadByte();
+    unsigned char const g = ReadByte();
+    unsigned char const b = ReadByte();
+    unsigned char const a = ReadByte();
+
+    return Rgba8(r, g, b, a);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool DefinitionCacheReader::ReadBytes(void* out_data, size_t const numBytes)
+{
+    if (!m_isValid || numBytes > m_buffer.size() - m_readOffset)
+    {
+        m_isValid = false;
+        memset(out_data, 0, numBytes);
+        return false;
+    }
+
+    memcpy(out_data, &m_buffer[m_readOffset], numBytes);
+    m_readOffset += numBytes;
+
+    return true;
+}
@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------------------------------------
+// DefinitionCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Baked binary copies of the XML definition files live under Data/Cache/. Each cache file starts with
+// a header holding DEFINITION_CACHE_VERSION and the FNV-1a hash of the XML it was baked from; a cache
+// whose version or hash does not match is ignored and the caller falls back to parsing the XML.
+// Bump DEFINITION_CACHE_VERSION whenever any Bake / cache-loading code changes its field order.
+//
+constexpr uint32_t DEFINITION_CACHE_VERSION = 2;
+
+uint64_t HashBytesFNV1a(unsigned char const* bytes, size_t numBytes);
+bool     ReadBinaryFile(char const* filePath, std::vector<unsigned char>& out_bytes);
+bool     HashFileContents(char const* filePath, uint64_t& out_hash);
+
+//----------------------------------------------------------------------------------------------------
+class DefinitionCacheWriter
+{
+public:
+    void WriteByte(unsigned char value);
+    void WriteBool(bool value);
+    void WriteInt(int value);
+    void WriteFloat(float value);
+    void WriteString(String const& value);
+    void WriteIntVec2(IntVec2 const& value);
+    void WriteRgba8(Rgba8 const& value);
+
+    bool SaveToFile(char const* cacheFilePath, uint64_t sourceHash) const;
+
+private:
+    void WriteBytes(void const* data, size_t numBytes);
+
+    std::vector<unsigned char> m_buffer;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Reads past the end (a truncated or corrupt cache) return zeroes and clear IsValid()
+class DefinitionCacheReader
+{
+public:
+    bool LoadFromFile(char const* cacheFilePath, uint64_t sourceHash);
+
+    unsigned char ReadByte();
+    bool          ReadBool();
+    int           ReadInt();
+    float         ReadFloat();
+    String        ReadString();
+    IntVec2       ReadIntVec2();
+    Rgba8         ReadRgba8();
+
+    bool IsValid() const { return m_isValid; }
+    bool IsAtEnd() const { return m_readOffset == m_buffer.size(); }
+
+private:
+    bool ReadBytes(void* out_data, size_t numBytes);
+
+    std::vector<unsigned char> m_buffer;
+    size_t                     m_readOffset = 0;
+    bool                       m_isValid    = false;
+};
@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// DistanceField.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/DistanceField.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/HeatMaps.hpp"
+
+//----------------------------------------------------------------------------------------------------
+DistanceField::DistanceField(IntVec2 const& dimensions, uint16_t const initialValue)
+{
+    Resize(dimensions, initialValue);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DistanceField::Resize(IntVec2 const& dimensions, uint16_t const initialValue)
+{
+    m_dimensions = dimensions;
+    m_values.assign(static_cast<size_t>(dimensions.x) * static_cast<size_t>(dimensions.y), initialValue);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DistanceField::FillAll(uint16_t const value)
+{
+    std::fill(m_values.begin(), m_values.end(), value);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Debug-draw only; this is the one place distances become floats
+void DistanceField::WriteToHeatMap(TileHeatMap const& heatMap, float const unreachableValue) const
+{
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+        {
+            uint16_t const value = GetValue(tileX, tileY);
+
+            heatMap.SetValueAtCoords(IntVec2(tileX, tileY), value == UNREACHABLE ? unreachableValue : static_cast<float>(value));
+        }
+    }
+}
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// DistanceField.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class TileHeatMap;
+
+//----------------------------------------------------------------------------------------------------
+// Tile distances as uint16, row-major, with an explicit UNREACHABLE sentinel that compares greater than
+// every real distance. This replaces the float-with-999 TileHeatMaps used for pathing; it is converted
+// to a TileHeatMap only when it is debug-drawn.
+//
+class DistanceField
+{
+public:
+    static constexpr uint16_t UNREACHABLE  = 0xFFFF;
+    static constexpr uint16_t MAX_DISTANCE = 0xFFFE;
+
+    DistanceField() = default;
+    explicit DistanceField(IntVec2 const& dimensions, uint16_t initialValue = UNREACHABLE);
+
+    void Resize(IntVec2 const& dimensions, uint16_t initialValue = UNREACHABLE);
+    void FillAll(uint16_t value);
+    void WriteToHeatMap(TileHeatMap const& heatMap, float unreachableValue) const;
+
+    uint16_t GetValue(int tileIndex) const { return m_values[tileIndex]; }
+    uint16_t GetValue(int tileX, int tileY) const { return m_values[tileY * m_dimensions.x + tileX]; }
+    uint16_t GetValue(IntVec2 const& tileCoords) const { return GetValue(tileCoords.x, tileCoords.y); }
+    void     SetValue(int tileIndex, uint16_t value) { m_values[tileIndex] = value; }
+    void     SetValue(int tileX, int tileY, uint16_t value) { m_values[tileY * m_dimensions.x + tileX] = value; }
+    bool     IsReachable(IntVec2 const& tileCoords) const { return GetValue(tileCoords) != UNREACHABLE; }
+
+    IntVec2         GetDimensions() const { return m_dimensions; }
+    int             GetNumTiles() const { return static_cast<int>(m_values.size()); }
+    uint16_t const* GetData() const { return m_values.data(); }
+    uint16_t*       GetData() { return m_values.data(); }
+
+private:
+    IntVec2               m_dimensions = IntVec2::ZERO;
+    std::vector<uint16_t> m_values;
+};
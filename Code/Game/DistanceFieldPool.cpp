@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// DistanceFieldPool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/DistanceFieldPool.hpp"
+
+#include "Game/DistanceField.hpp"
+
+//----------------------------------------------------------------------------------------------------
+DistanceFieldPool::~DistanceFieldPool()
+{
+    Reset(IntVec2::ZERO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Deletes every field, including any still on loan, so callers must not hold on to them
+void DistanceFieldPool::Reset(IntVec2 const& dimensions)
+{
+    for (DistanceField const* field : m_allFields)
+    {
+        delete field;
+    }
+
+    m_allFields.clear();
+    m_freeFields.clear();
+    m_dimensions = dimensions;
+}
+
+//----------------------------------------------------------------------------------------------------
+DistanceField* DistanceFieldPool::Acquire()
+{
+    if (!m_freeFields.empty())
+    {
+        DistanceField* field = m_freeFields.back();
+        m_freeFields.pop_back();
+        return field;
+    }
+
+    DistanceField* field = new DistanceField(m_dimensions);
+    m_allFields.push_back(field);
+    return field;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DistanceFieldPool::Release(DistanceField*& field)
+{
+    if (!field) return;
+
+    m_freeFields.push_back(field);
+    field = nullptr;
+}
@@ -0,0 +1,39 @@
+//----------------------------------------------------------------------------------------------------
+// DistanceFieldPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class DistanceField;
+
+//----------------------------------------------------------------------------------------------------
+// Owns every DistanceField of one map size. Acquire hands out a free one (allocating only when none is
+// left), Release gives it back for reuse. Values are not reset in between; every PopulateDistanceField*
+// overwrites the whole field anyway. All fields are deleted with the pool.
+//
+class DistanceFieldPool
+{
+public:
+    DistanceFieldPool() = default;
+    ~DistanceFieldPool();
+
+    DistanceFieldPool(DistanceFieldPool const&)            = delete;
+    DistanceFieldPool& operator=(DistanceFieldPool const&) = delete;
+
+    void           Reset(IntVec2 const& dimensions);
+    DistanceField* Acquire();
+    void           Release(DistanceField*& field);
+
+    int GetNumAllocated() const { return static_cast<int>(m_allFields.size()); }
+    int GetNumFree() const { return static_cast<int>(m_freeFields.size()); }
+
+private:
+    IntVec2                     m_dimensions = IntVec2::ZERO;
+    std::vector<DistanceField*> m_allFields;
+    std::vector<DistanceField*> m_freeFields;
+};
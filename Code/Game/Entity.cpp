@@ -5,7 +5,6 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Entity.hpp"
 
-#include "Engine/Core/HeatMaps.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/Renderer.hpp"
@@ -92,13 +91,21 @@ void Entity::UpdateBehavior(float const deltaSeconds, bool const isChasing)
 {
     PlayerTank const* playerTank = g_game->GetPlayerTank();
 
-    // Update or initialize the heat map and target position
-    if (!m_heatMap ||
-        (isChasing && m_goalPosition != playerTank->m_position))
+    bool const isFirstUpdate = !m_hasStartedBehavior;
+
+    m_hasStartedBehavior = true;
+
+    // Replans are solved by the Map within its frame budget; keep following the old path until one lands
+    if (m_pathRequestHandle != INVALID_PATH_REQUEST_HANDLE &&
+        m_map->TakeEntityPathResult(m_pathRequestHandle, m_pathPoints))
     {
-        // Create a new heat map with high initial values
-        m_heatMap = new TileHeatMap(m_map->GetMapDimension(), 999.f);
+        m_pathRequestHandle = INVALID_PATH_REQUEST_HANDLE;
+    }
 
+    // Update the target position
+    if (isFirstUpdate ||
+        (isChasing && m_goalPosition != playerTank->m_position))
+    {
         if (isChasing)
         {
             // Chasing mode: Set the target to the player's current position
@@ -114,21 +121,22 @@ void Entity::UpdateBehavior(float const deltaSeconds, bool const isChasing)
         else
         {
             // Wandering mode: Set a random traversable tile as the target
-            IntVec2 const randomCoords = m_map->RollRandomTraversableTileCoords(*m_heatMap, IntVec2(m_position));
+            IntVec2 const randomCoords = RollWanderGoalCoords();
             m_goalPosition             = m_map->GetWorldPosFromTileCoords(randomCoords);
 
             // Reset discover sound flag when switching to wandering mode
             m_hasPlayedDiscoverSound = false;
         }
 
-        // Generate heat maps and distance fields for pathfinding
-        m_pathPoints = m_map->GenerateEntityPathToGoal(*m_heatMap, m_position, m_goalPosition);
+        RequestPathToGoal(isChasing);
     }
 
-    // If path is empty, regenerate path
+    // If path is empty, regenerate path, and wait for it unless one is already on the way
     if (m_pathPoints.empty())
     {
-        m_pathPoints = m_map->GenerateEntityPathToGoal(*m_heatMap, m_position, m_goalPosition);
+        if (m_pathRequestHandle == INVALID_PATH_REQUEST_HANDLE) RequestPathToGoal(isChasing);
+
+        return;
     }
 
     // Path navigation logic
@@ -150,11 +158,12 @@ void Entity::UpdateBehavior(float const deltaSeconds, bool const isChasing)
     // If path is empty, choose a new target
     if (m_pathPoints.empty())
     {
-        IntVec2 randomCoords     = m_map->RollRandomTraversableTileCoords(*m_heatMap, IntVec2(m_position));
+        IntVec2 randomCoords     = RollWanderGoalCoords();
         m_goalPosition           = m_map->GetWorldPosFromTileCoords(randomCoords);
-        m_pathPoints             = m_map->GenerateEntityPathToGoal(*m_heatMap, m_position, m_goalPosition);
         m_hasTarget              = false;
         m_hasPlayedDiscoverSound = false; // Reset sound flag
+        RequestPathToGoal(false);
+        return;
     }
 
     // Set target to the last point in the path
@@ -167,7 +176,30 @@ void Entity::UpdateBehavior(float const deltaSeconds, bool const isChasing)
     MoveToward(m_position, nextPosition, m_moveSpeed, deltaSeconds);
 }
 
+//----------------------------------------------------------------------------------------------------
+// A request still waiting in the Map's queue is re-aimed rather than queued twice
+void Entity::RequestPathToGoal(bool const isChasing)
+{
+    PathRequest request;
+
+    request.m_start       = m_position;
+    request.m_goal        = m_goalPosition;
+    request.m_passability = m_canSwim ? TILE_PASSABILITY_AMPHIBIAN : TILE_PASSABILITY_LAND_AVOID_SCORPIO;
+    request.m_isChasing   = isChasing;
+
+    m_pathRequestHandle = m_map->RequestEntityPath(m_pathRequestHandle, request);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Land movers and swimmers both draw from the Map's region index for their passability
+IntVec2 Entity::RollWanderGoalCoords() const
+{
+    TilePassability const passability = m_canSwim ? TILE_PASSABILITY_AMPHIBIAN : TILE_PASSABILITY_LAND_AVOID_SCORPIO;
+
+    return m_map->RollRandomTraversableTileCoords(IntVec2(m_position), passability);
+}
 
+//----------------------------------------------------------------------------------------------------
 void Entity::RenderHealthBar() const
 {
     VertexList_PCU  verts;
@@ -7,13 +7,14 @@
 #include <vector>
 
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/Vec2.hpp"
+#include "Game/PathRequestQueue.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Map;
 class Entity;
 class Texture;
-class TileHeatMap;
 typedef std::vector<Entity*> EntityList;
 
 //----------------------------------------------------------------------------------------------------
@@ -56,6 +57,8 @@ public:
     void         MoveToward(Vec2& currentPosition, Vec2 const& targetPosition, float moveSpeed, float deltaSeconds);
     void         WanderAround(float deltaSeconds, float moveSpeed, float rotateSpeed);
     void         UpdateBehavior(float deltaSeconds, bool isChasing);
+    void              RequestPathToGoal(bool isChasing);
+    IntVec2           RollWanderGoalCoords() const;
     void         RenderHealthBar() const;
 
 // TODO: MAKE THIS
@@ -70,7 +73,7 @@ public:
     // Vec2              m_nextWayPosition         = Vec2::ZERO;
     Vec2              m_goalPosition            = Vec2::ZERO;
     std::vector<Vec2> m_pathPoints;
-    TileHeatMap*      m_heatMap = nullptr;
+    PathRequestHandle m_pathRequestHandle = INVALID_PATH_REQUEST_HANDLE;
     AABB2             m_bodyBounds = AABB2::NEG_HALF_TO_HALF;
     Texture const*    m_bodyTexture              = nullptr;
     float             m_moveSpeed                = 0.f;
@@ -91,4 +94,5 @@ public:
     bool              m_hasTarget                = false;
     bool              m_isChasing                = false;
     bool              m_hasPlayedDiscoverSound   = false;
+    bool              m_hasStartedBehavior       = false;    // Set by the first UpdateBehavior
 };
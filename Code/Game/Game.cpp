@@ -5,6 +5,8 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Game.hpp"
 
+#include <climits>
+
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
@@ -12,6 +14,7 @@
 #include "Engine/Core/SimpleTriangleFont.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
@@ -22,6 +25,7 @@
 #include "Game/GameCommon.hpp"
 #include "Game/Map.hpp"
 #include "Game/PlayerTank.hpp"
+#include "Game/SeededRandomStream.hpp"
 
 
 //----------------------------------------------------------------------------------------------------
@@ -60,11 +64,17 @@ Game::Game()
 //----------------------------------------------------------------------------------------------------
 Game::~Game()
 {
+    if (m_nextMapGeneration.valid()) m_nextMapGeneration.wait();
+
+    delete m_nextMap;
+    m_nextMap = nullptr;
+
+    // The player outlives every map, so take it out before the map deletes its entities
+    if (m_currentMap && m_playerTank) m_currentMap->RemoveEntityFromMap(m_playerTank);
+
     delete m_currentMap;
     m_currentMap = nullptr;
 
-    m_maps.clear();
-
     delete m_playerTank;
     m_playerTank = nullptr;
 
@@ -110,7 +120,7 @@ void Game::Update(float deltaSeconds)
     if (m_currentMap->GetTileCoordsFromWorldPos(m_playerTank->m_position).x == m_currentMap->GetMapExitPosition().x &&
         m_currentMap->GetTileCoordsFromWorldPos(m_playerTank->m_position).y == m_currentMap->GetMapExitPosition().y)
     {
-        if (m_currentMap->GetMapIndex() == 2)
+        if (IsOnLastMap())
         {
             m_isPaused      = true;
             m_isGameWinMode = true;
@@ -182,19 +192,55 @@ void Game::InitializeMaps()
 
     MapDefinition::InitializeMapDefs();
 
-    m_maps.reserve(3);
+    // Every map draws from its own stream derived from one base seed, so the result does not depend
+    // on which thread generates it or when. Set mapGenerationSeed to replay a run.
+    m_baseMapSeed = g_gameConfigBlackboard.GetValue("mapGenerationSeed", -1);
 
-    for (int mapIndex = 0; mapIndex < 3; ++mapIndex)
+    if (m_baseMapSeed < 0)
     {
-        m_maps.push_back(new Map(*MapDefinition::s_mapDefinitions[mapIndex]));
+        m_baseMapSeed = g_rng->RollRandomIntInRange(0, INT_MAX);
     }
 
-    m_currentMap = m_maps[0];
+    printf("( Game ) Seed   | mapGenerationSeed=%d\n", m_baseMapSeed);
+
+    // The second map generates in the background while the first is built here
+    m_currentMap = CreateMap(0);
+    BeginGeneratingNextMap(1);
+
+    m_currentMap->GenerateTiles();
+    m_currentMap->SpawnInitialEntities();
 
     printf("( Game ) Finish | InitializeMaps\n");
 }
 
 
+//----------------------------------------------------------------------------------------------------
+Map* Game::CreateMap(int const mapIndex) const
+{
+    unsigned int const mapSeed = SeededRandomStream::Squirrel3(mapIndex, static_cast<unsigned int>(m_baseMapSeed));
+
+    return new Map(*MapDefinition::s_mapDefinitions[mapIndex], mapSeed);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Kicks off tile generation for mapIndex on a background thread; UpdateCurrentMap picks it up.
+// Does nothing past the last map.
+void Game::BeginGeneratingNextMap(int const mapIndex)
+{
+    if (mapIndex >= static_cast<int>(MapDefinition::s_mapDefinitions.size())) return;
+
+    Map* nextMap = CreateMap(mapIndex);
+
+    m_nextMap           = nextMap;
+    m_nextMapGeneration = std::async(std::launch::async, [nextMap]() { nextMap->GenerateTiles(); });
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Game::IsOnLastMap() const
+{
+    return m_currentMap->GetMapIndex() == static_cast<int>(MapDefinition::s_mapDefinitions.size()) - 1;
+}
+
 //----------------------------------------------------------------------------------------------------
 void Game::InitializeTiles()
 {
@@ -322,9 +368,14 @@ void Game::UpdateFromKeyBoard()
             m_isDebugCamera = !m_isDebugCamera;
         }
 
+        if (g_input->WasKeyJustPressed(KEYCODE_F7))
+        {
+            m_currentMap->SaveSnapshot();
+        }
+
         if (g_input->WasKeyJustPressed(KEYCODE_F9))
         {
-            if (m_currentMap->GetMapIndex() == 2)
+            if (IsOnLastMap())
             {
                 m_isPaused      = true;
                 m_isGameWinMode = true;
@@ -481,7 +532,7 @@ void Game::UpdateFromController()
 
         if (controller.WasButtonJustPressed(XBOX_BUTTON_B))
         {
-            if (m_currentMap->GetMapIndex() == 2)
+            if (IsOnLastMap())
             {
                 m_isPaused      = true;
                 m_isGameWinMode = true;
@@ -571,8 +622,19 @@ void Game::UpdateCurrentMap()
     Vec2 const  playerTankInitPosition           = g_gameConfigBlackboard.GetValue("playerTankInitPosition", Vec2(2.f, 2.f));
     float const playerTankInitOrientationDegrees = g_gameConfigBlackboard.GetValue("playerTankInitOrientationDegrees", 30.f);
 
+    if (!m_nextMap) return;
+
+    // Usually long finished by now; only blocks if the player reached the exit before generation did
+    m_nextMapGeneration.get();
+    m_nextMap->SpawnInitialEntities();
+
     m_currentMap->RemoveEntityFromMap(m_playerTank);
-    m_currentMap = m_maps[currentMapIndex + 1];
+    delete m_currentMap;
+
+    m_currentMap = m_nextMap;
+    m_nextMap    = nullptr;
+    BeginGeneratingNextMap(currentMapIndex + 2);
+
     m_currentMap->AddEntityToMap(m_playerTank,
                                  playerTankInitPosition,
                                  playerTankInitOrientationDegrees);
@@ -4,6 +4,8 @@
 
 //-----------------------------------------------------------------------------------------------
 #pragma once
+#include <future>
+
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Math/Vec2.hpp"
 #include "Game/TileDefinition.hpp"
@@ -42,6 +44,9 @@ public:
 
 private:
     void InitializeMaps();
+    Map* CreateMap(int mapIndex) const;
+    void BeginGeneratingNextMap(int mapIndex);
+    bool IsOnLastMap() const;
     void InitializeTiles();
     void InitializeAudio();
 
@@ -75,8 +80,11 @@ private:
     bool    m_glowIncreasing          = false;
     Vec2    m_baseCameraPos           = Vec2::ZERO;
 
-    std::vector<Map*> m_maps;
+    // Only the current map and the one after it are resident; the next one generates in the background
     Map*              m_currentMap      = nullptr;
+    Map*              m_nextMap         = nullptr;
+    std::future<void> m_nextMapGeneration;
+    int               m_baseMapSeed     = 0;
     SpriteSheet*      m_tileSpriteSheet = nullptr;
     PlayerTank*       m_playerTank      = nullptr;
 
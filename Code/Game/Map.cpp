@@ -5,8 +5,13 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Map.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
-#include <queue>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 
 #include "Debris.hpp"
 #include "Explosion.hpp"
@@ -14,6 +19,7 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/HeatMaps.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -29,43 +35,135 @@
 #include "Game/GameCommon.hpp"
 #include "Game/Leo.hpp"
 #include "Game/MapDefinition.hpp"
+#include "Game/MapSnapshot.hpp"
 #include "Game/PlayerTank.hpp"
 #include "Game/Scorpio.hpp"
 #include "Game/Tile.hpp"
+#include "Game/TileRaycaster.hpp"
 
 //----------------------------------------------------------------------------------------------------
-Map::Map(MapDefinition const& mapDef)
-    : m_mapDef(&mapDef)
+Map::Map(MapDefinition const& mapDef, unsigned int const generationSeed)
+    : m_mapDef(&mapDef),
+      m_generationRng(generationSeed)
 {
     m_dimensions = mapDef.GetDimensions();
-    m_tiles.reserve(static_cast<size_t>(m_dimensions.x) * static_cast<size_t>(m_dimensions.y));
     m_startPosition = IntVec2::ONE;
     m_exitPosition  = IntVec2(m_dimensions.x - 2, m_dimensions.y - 2);
+    m_solidBits.Resize(m_dimensions);
+    m_waterBits.Resize(m_dimensions);
+    m_scorpioBits.Resize(m_dimensions);
 
-    InitializeTileHeatMaps();
-    GenerateAllTiles();
-    SpawnNewNPCs();
-    // GenerateHeatMaps(*m_tileHeatMaps[0]);
-    // GenerateHeatMaps(*m_tileHeatMaps[1]);
-    // GenerateHeatMaps(*m_tileHeatMaps[2]);
-    // GenerateHeatMaps(*m_tileHeatMaps[3]);
-    PopulateDistanceField(*m_tileHeatMaps[0], m_startPosition, 999.f);
-    PopulateDistanceFieldForLandBased(*m_tileHeatMaps[1]);
-    PopulateDistanceFieldForAmphibian(*m_tileHeatMaps[2]);
-    PopulateDistanceFieldForEntity(*m_tileHeatMaps[3], m_startPosition, 999.f);
+    m_stoneTileTypeIndex = TileDefinition::GetTileTypeIndexByName("Stone");
+    m_floorTileTypeIndex = TileDefinition::GetTileTypeIndexByName("Floor");
+    m_startTileTypeIndex = TileDefinition::GetTileTypeIndexByName("Start");
+    m_exitTileTypeIndex  = TileDefinition::GetTileTypeIndexByName("Exit");
+
+    m_tiles.Resize(m_dimensions, m_stoneTileTypeIndex);
+    m_tileDirtyTracker.Reset(m_dimensions);
+    m_distanceFieldPool.Reset(m_dimensions);
+    m_scratchDistanceField = m_distanceFieldPool.Acquire();
+
+    m_pathRequestBudgetSeconds = g_gameConfigBlackboard.GetValue("pathRequestBudgetMilliseconds", 1.f) * 0.001;
+
+    // Leo and Capricorn share leoDetectRange
+    m_playerVisibilityRange = std::max(g_gameConfigBlackboard.GetValue("leoDetectRange", 10.f),
+                                       std::max(g_gameConfigBlackboard.GetValue("ariesDetectRange", 10.f),
+                                                g_gameConfigBlackboard.GetValue("scorpioDetectRange", 0.f)));
+
+    // LoadSnapshot rejects tables past MAX_VISIBILITY_TABLE_RADIUS, and the table grows with radius squared
+    int const visibilityTableRadius = g_gameConfigBlackboard.GetValue("visibilityTableRadius", 0);
+
+    m_visibilityTableRadius = std::clamp(visibilityTableRadius, 0, MAX_VISIBILITY_TABLE_RADIUS);
+
+    if (m_visibilityTableRadius != visibilityTableRadius)
+    {
+        printf("WARNING: visibilityTableRadius %d is outside [0, %d], clamped to %d\n", visibilityTableRadius, MAX_VISIBILITY_TABLE_RADIUS, m_visibilityTableRadius);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// A snapshot replaces generation only when the MapDefinition names one, so F7 captures never leak into
+// seeded runs
+void Map::GenerateTiles()
+{
+    String const& snapshotFilePath = m_mapDef->GetSnapshotFilePath();
+
+    if (!snapshotFilePath.empty())
+    {
+        m_isLoadedFromSnapshot = LoadSnapshot(snapshotFilePath);
+
+        if (m_isLoadedFromSnapshot)
+        {
+            printf("( Map%d ) Using snapshot \"%s\" instead of generation\n", m_mapDef->GetIndex(), snapshotFilePath.c_str());
+        }
+        else
+        {
+            printf("( Map%d ) WARNING: snapshot \"%s\" could not be used, generating instead\n", m_mapDef->GetIndex(), snapshotFilePath.c_str());
+        }
+    }
+
+    if (!m_isLoadedFromSnapshot)
+    {
+        GenerateAllTiles();
+    }
+
+    BuildPathLandmarksIfStale();
+
+    // Wanderers plan on these from their first update, so build them with the tiles
+    for (TilePassability const passability : {TILE_PASSABILITY_LAND_AVOID_SCORPIO, TILE_PASSABILITY_AMPHIBIAN})
+    {
+        BuildBlockedBits(passability, m_blockedBits);
+        RefreshClusterGraph(passability, m_blockedBits);
+    }
+
+    SyncWanderRegionIndices();
+    BuildVisibilityTableIfNeeded();
+}
+
+//----------------------------------------------------------------------------------------------------
+// A map can be rendered before its first Update (the frame Game switches to it), so lasers are traced here too
+void Map::SpawnInitialEntities()
+{
+    if (!m_isLoadedFromSnapshot)
+    {
+        SpawnNewNPCs();
+    }
+    else
+    {
+        for (MapSnapshotSpawn const& spawn : m_snapshotSpawns)
+        {
+            SpawnNewEntity(static_cast<EntityType>(spawn.m_type),
+                           static_cast<EntityFaction>(spawn.m_faction),
+                           Vec2(spawn.m_positionX, spawn.m_positionY),
+                           spawn.m_orientationDegrees);
+        }
+
+        m_snapshotSpawns.clear();
+    }
+
+    TraceScorpioLasers();
 }
 
 //----------------------------------------------------------------------------------------------------
 Map::~Map()
 {
+    // Anything still on the map is owned by it (the player is removed before a map is discarded)
+    for (Entity const* entity : m_allEntities)
+    {
+        delete entity;
+    }
+
     m_allEntities.clear();
     m_entitiesByType->clear();
     m_agentsByFaction->clear();
     m_bulletsByFaction->clear();
-    m_tiles.clear();
+
+    // Distance fields (debug, flow fields, wander scratch) are all freed with m_distanceFieldPool
     m_tileHeatMaps.clear();
 
-    delete m_currentSelectedEntity;
+    delete m_debugDrawHeatMap;
+    m_debugDrawHeatMap = nullptr;
+
     m_currentSelectedEntity = nullptr;
 }
 
@@ -85,6 +183,11 @@ void Map::Update(float const deltaSeconds)
             m_currentTileHeatMapIndex = -1;
         }
 
+        if (m_currentTileHeatMapIndex == 0)
+        {
+            CreateTileHeatMapsIfNeeded();
+        }
+
         if (m_currentTileHeatMapIndex == 3)
         {
             for (Entity* entity : m_allEntities)
@@ -108,11 +211,16 @@ void Map::Update(float const deltaSeconds)
     }
 
 
+    RefreshDirtyTileHeatMaps();
+    RefreshPlayerVisibility();
+
     UpdateEntities(deltaSeconds);
     PushEntitiesOutOfEachOther(m_allEntities, m_allEntities);
     CheckEntityVsEntityCollision(m_entitiesByType[ENTITY_TYPE_BULLET], m_allEntities);
     PushEntitiesOutOfWalls();
     DeleteGarbageEntities();
+    TraceScorpioLasers();
+    ServicePathRequests();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -181,6 +289,21 @@ bool Map::HasLineOfSight(Vec2 const& startPos,
 
     if (distSquared >= sighRangeSquared) return false;
 
+    // Static terrain settles most pairs without a ray; only partly visible pairs fall through
+    TileVisibility const tileVisibility = GetTileVisibility(GetTileCoordsFromWorldPos(startPos), GetTileCoordsFromWorldPos(endPos));
+
+    if (tileVisibility == TILE_VISIBILITY_CLEAR) return true;
+    if (tileVisibility == TILE_VISIBILITY_HIDDEN) return false;
+
+    // Toward the player's tile, the shadowcast field answers for every caller at once
+    if (m_playerVisibility.IsComputed() &&
+        m_playerVisibilityGeneration == m_tileDirtyTracker.GetGeneration() &&
+        sightRange <= m_playerVisibilityRange &&
+        GetTileCoordsFromWorldPos(endPos) == m_playerVisibility.GetOriginCoords())
+    {
+        return m_playerVisibility.IsVisible(GetTileCoordsFromWorldPos(startPos));
+    }
+
     Vec2 const  fwdNormal = (endPos - startPos).GetNormalized();
     float const maxDist   = GetDistance2D(startPos, endPos);
     Ray2 const  ray       = Ray2(startPos, fwdNormal, maxDist);
@@ -189,38 +312,45 @@ bool Map::HasLineOfSight(Vec2 const& startPos,
 }
 
 //----------------------------------------------------------------------------------------------------
-bool Map::IsTileSolid(IntVec2 const& tileCoords) const
+// TILE_VISIBILITY_UNKNOWN if there is no table, it went stale, or the tiles are further apart than its radius
+TileVisibility Map::GetTileVisibility(IntVec2 const& fromCoords, IntVec2 const& toCoords) const
 {
-    if (IsTileCoordsOutOfBounds(tileCoords)) return true;
+    if (!IsVisibilityTableCurrent()) return TILE_VISIBILITY_UNKNOWN;
 
-    int const tileIndex = tileCoords.y * m_dimensions.x + tileCoords.x;
-
-    if (tileIndex >= 0 &&
-        tileIndex < static_cast<int>(m_tiles.size()))
-    {
-        Tile const& tile = m_tiles[tileIndex];
+    return m_visibilityTable.GetVisibility(fromCoords, toCoords);
+}
 
-        return TileDefinition::GetTileDefByName(tile.m_name)->IsSolid() == true;
-    }
+//----------------------------------------------------------------------------------------------------
+bool Map::IsTileSolid(IntVec2 const& tileCoords) const
+{
+    if (IsTileCoordsOutOfBounds(tileCoords)) return true;
 
-    return false;
+    return m_solidBits.IsSet(tileCoords);
 }
 
+//----------------------------------------------------------------------------------------------------
 bool Map::IsTileWater(IntVec2 const& tileCoords) const
 {
     if (IsTileCoordsOutOfBounds(tileCoords)) return true;
 
-    int const tileIndex = tileCoords.y * m_dimensions.x + tileCoords.x;
+    return m_waterBits.IsSet(tileCoords);
+}
 
-    if (tileIndex >= 0 &&
-        tileIndex < static_cast<int>(m_tiles.size()))
-    {
-        Tile const& tile = m_tiles[tileIndex];
+//----------------------------------------------------------------------------------------------------
+bool Map::IsTileOccupiedByScorpio(IntVec2 const& tileCoords) const
+{
+    if (IsTileCoordsOutOfBounds(tileCoords)) return false;
 
-        return TileDefinition::GetTileDefByName(tile.m_name)->IsWater() == true;
-    }
+    return m_scorpioBits.IsSet(tileCoords);
+}
 
-    return false;
+//----------------------------------------------------------------------------------------------------
+// Walls stop rays and bullets; water is solid to walkers but not to rays, and the map edge is a wall
+bool Map::DoesTileBlockRays(IntVec2 const& tileCoords) const
+{
+    if (IsTileCoordsOutOfBounds(tileCoords)) return true;
+
+    return m_solidBits.IsSet(tileCoords) && !m_waterBits.IsSet(tileCoords);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -247,32 +377,63 @@ void Map::UpdateEntities(float const deltaSeconds) const
 //----------------------------------------------------------------------------------------------------
 void Map::RenderTiles() const
 {
-    VertexList_PCU tileVertices;
+    RebuildDirtyTileVerts();
 
-    tileVertices.reserve(static_cast<size_t>(3) * 2 * m_dimensions.x * m_dimensions.y);
+    g_renderer->BindTexture(&g_game->GetTileSpriteSheet()->GetTexture());
 
-    for (String const& tileName : TileDefinition::GetTileNames())
+    for (VertexList_PCU const& chunkVerts : m_tileVertsByChunk)
     {
-        TileDefinition const*  tileDef   = TileDefinition::GetTileDefByName(tileName);
-        SpriteDefinition const spriteDef = tileDef->GetSpriteDef();
+        g_renderer->DrawVertexArray(static_cast<int>(chunkVerts.size()), chunkVerts.data());
+    }
+}
 
-        Vec2 const uvAtMins = spriteDef.GetUVsMins();
-        Vec2 const uvAtMaxs = spriteDef.GetUVsMaxs();
+//----------------------------------------------------------------------------------------------------
+// Only the chunks overlapping tiles changed since the last render get their vertices rebuilt
+void Map::RebuildDirtyTileVerts() const
+{
+    IntVec2 dirtyMins;
+    IntVec2 dirtyMaxs;
 
-        for (Tile const& tile : m_tiles)
-        {
-            if (tile.m_name == tileName)
-            {
-                Vec2 const mins(static_cast<float>(tile.m_coords.x), static_cast<float>(tile.m_coords.y));
-                Vec2 const maxs = mins + Vec2::ONE;
+    if (!m_tileDirtyTracker.GetDirtyRectSince(m_tileVertsGeneration, dirtyMins, dirtyMaxs)) return;
 
-                AddVertsForAABB2D(tileVertices, AABB2(mins, maxs), tileDef->GetTintColor(), uvAtMins, uvAtMaxs);
-            }
+    m_tileVertsGeneration = m_tileDirtyTracker.GetGeneration();
+
+    IntVec2 const chunkDimensions = m_tiles.GetChunkDimensions();
+
+    m_tileVertsByChunk.resize(static_cast<size_t>(chunkDimensions.x) * static_cast<size_t>(chunkDimensions.y));
+
+    for (int chunkY = dirtyMins.y >> TileChunkGrid::CHUNK_SIZE_SHIFT; chunkY <= dirtyMaxs.y >> TileChunkGrid::CHUNK_SIZE_SHIFT; ++chunkY)
+    {
+        for (int chunkX = dirtyMins.x >> TileChunkGrid::CHUNK_SIZE_SHIFT; chunkX <= dirtyMaxs.x >> TileChunkGrid::CHUNK_SIZE_SHIFT; ++chunkX)
+        {
+            RebuildTileVertsForChunk(chunkX, chunkY);
         }
     }
+}
 
-    g_renderer->BindTexture(&g_game->GetTileSpriteSheet()->GetTexture());
-    g_renderer->DrawVertexArray(static_cast<int>(tileVertices.size()), tileVertices.data());
+//----------------------------------------------------------------------------------------------------
+void Map::RebuildTileVertsForChunk(int const chunkX, int const chunkY) const
+{
+    VertexList_PCU& chunkVerts = m_tileVertsByChunk[chunkY * m_tiles.GetChunkDimensions().x + chunkX];
+
+    int const minX = chunkX << TileChunkGrid::CHUNK_SIZE_SHIFT;
+    int const minY = chunkY << TileChunkGrid::CHUNK_SIZE_SHIFT;
+    int const maxX = std::min(minX + TileChunkGrid::CHUNK_SIZE, m_dimensions.x);
+    int const maxY = std::min(minY + TileChunkGrid::CHUNK_SIZE, m_dimensions.y);
+
+    chunkVerts.clear();
+    chunkVerts.reserve(static_cast<size_t>(6) * (maxX - minX) * (maxY - minY));
+
+    for (int tileY = minY; tileY < maxY; ++tileY)
+    {
+        for (int tileX = minX; tileX < maxX; ++tileX)
+        {
+            TileDefinition const* tileDef = TileDefinition::GetTileDefByIndex(m_tiles.GetTileTypeIndex(tileX, tileY));
+            AABB2 const           uvs     = tileDef->GetUVs();
+
+            AddVertsForAABB2D(chunkVerts, GetTileBounds(IntVec2(tileX, tileY)), tileDef->GetTintColor(), uvs.m_mins, uvs.m_maxs);
+        }
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -290,27 +451,41 @@ void Map::RenderEntities() const
 //----------------------------------------------------------------------------------------------------
 void Map::RenderTileHeatMap() const
 {
-    if (m_currentTileHeatMapIndex == -1) return;
+    DistanceField const* field = GetDebugDistanceField();
+
+    if (!field) return;
 
-    AABB2 const totalBounds = GetMapBound();
+    if (!m_debugDrawHeatMap)
+    {
+        m_debugDrawHeatMap = new TileHeatMap(m_dimensions, 999.f);
+    }
+
+    field->WriteToHeatMap(*m_debugDrawHeatMap, 999.f);
 
     VertexList_PCU verts;
+    m_debugDrawHeatMap->AddVertsForDebugDraw(verts, GetMapBound());
+
+    g_renderer->BindTexture(nullptr);
+    g_renderer->DrawVertexArray(static_cast<int>(verts.size()), verts.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+// F6 index 3 floods from the selected entity on every draw (debug only), the others are the map's debug fields
+DistanceField const* Map::GetDebugDistanceField() const
+{
+    if (m_currentTileHeatMapIndex == -1) return nullptr;
 
     if (m_currentTileHeatMapIndex == 3)
     {
-        if (!m_currentSelectedEntity->m_heatMap) return;
+        if (!m_currentSelectedEntity) return nullptr;
 
-        m_currentSelectedEntity->m_heatMap->AddVertsForDebugDraw(verts, totalBounds);
+        PopulateDistanceFieldForEntity(*m_scratchDistanceField, GetTileCoordsFromWorldPos(m_currentSelectedEntity->m_position));
+        return m_scratchDistanceField;
     }
-    else
-    {
-        if (!m_tileHeatMaps[m_currentTileHeatMapIndex]) return;
 
-        m_tileHeatMaps[m_currentTileHeatMapIndex]->AddVertsForDebugDraw(verts, totalBounds);
-    }
+    if (m_currentTileHeatMapIndex >= static_cast<int>(m_tileHeatMaps.size())) return nullptr;
 
-    g_renderer->BindTexture(nullptr);
-    g_renderer->DrawVertexArray(static_cast<int>(verts.size()), verts.data());
+    return m_tileHeatMaps[m_currentTileHeatMapIndex];
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -346,7 +521,7 @@ void Map::RenderTileHeatMapText() const
         break;
 
     case 3:
-        bitmapFont->AddVertsForTextInBox2D(textVerts, "Debug Heat Map: Distance Map to selected Entity's goal (F6 for next mode)", box, 0.5f);
+        bitmapFont->AddVertsForTextInBox2D(textVerts, "Debug Heat Map: Distance Map from selected Entity (F6 for next mode)", box, 0.5f);
         break;
     }
 
@@ -366,32 +541,19 @@ void Map::DebugRenderEntities() const
 //----------------------------------------------------------------------------------------------------
 void Map::DebugRenderTileIndex() const
 {
-    if (m_currentTileHeatMapIndex == -1) return;
+    DistanceField const* field = GetDebugDistanceField();
+
+    if (!field) return;
 
     for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
     {
         for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
         {
-            TileHeatMap const* heatMap;
-
-            if (m_currentTileHeatMapIndex == 3)
-            {
-                if (!m_currentSelectedEntity->m_heatMap) return;
+            uint16_t const value = field->GetValue(tileX, tileY);
+            VertexList_PCU textVerts;
 
-                heatMap = m_currentSelectedEntity->m_heatMap;
-            }
-            else
-            {
-                if (!m_tileHeatMaps[m_currentTileHeatMapIndex]) return;
-
-                heatMap = m_tileHeatMaps[m_currentTileHeatMapIndex];
-            }
-
-            float const value = heatMap->GetValueAtCoords(tileX, tileY);
-            VertexList_PCU  textVerts;
-
-            BitmapFont*    bitmapFont = g_resourceSubsystem->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont");
-            bitmapFont->AddVertsForText2D(textVerts, std::to_string(static_cast<int>(value)), Vec2(tileX, tileY), 0.2f, Rgba8::WHITE);
+            BitmapFont* bitmapFont = g_resourceSubsystem->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont");
+            bitmapFont->AddVertsForText2D(textVerts, value == DistanceField::UNREACHABLE ? "999" : std::to_string(value), Vec2(tileX, tileY), 0.2f, Rgba8::WHITE);
             g_renderer->BindTexture(&bitmapFont->GetTexture());
             g_renderer->DrawVertexArray(static_cast<int>(textVerts.size()), textVerts.data());
         }
@@ -399,77 +561,336 @@ void Map::DebugRenderTileIndex() const
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::InitializeTileHeatMaps()
+// The debug heat maps are dense, so they are only built once someone actually looks at them
+void Map::CreateTileHeatMapsIfNeeded()
 {
+    if (!m_tileHeatMaps.empty()) return;
+
     m_tileHeatMaps.reserve(4);
 
     for (int i = 0; i < 4; ++i)
     {
-        m_tileHeatMaps.push_back(new TileHeatMap(m_dimensions, 999.f));
+        m_tileHeatMaps.push_back(m_distanceFieldPool.Acquire());
     }
+
+    PopulateDistanceField(*m_tileHeatMaps[0], m_startPosition);
+    PopulateDistanceFieldForLandBased(*m_tileHeatMaps[1]);
+    PopulateDistanceFieldForAmphibian(*m_tileHeatMaps[2]);
+    PopulateDistanceFieldForEntity(*m_tileHeatMaps[3], m_startPosition);
+
+    m_tileHeatMapsGeneration = m_tileDirtyTracker.GetGeneration();
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::GenerateAllTiles()
+// The solid maps are per-tile, so only the dirty rect is rewritten. The distance maps are repaired from
+// the same rect, which revisits only the tiles whose distance depends on what changed.
+void Map::RefreshDirtyTileHeatMaps()
 {
-    printf("( Map%d ) Start  | GenerateAllTiles\n", m_mapDef->GetIndex());
+    if (m_tileHeatMaps.empty()) return;
 
-    for (int y = 0; y < m_dimensions.y; ++y)
+    IntVec2 dirtyMins;
+    IntVec2 dirtyMaxs;
+
+    if (!m_tileDirtyTracker.GetDirtyRectSince(m_tileHeatMapsGeneration, dirtyMins, dirtyMaxs)) return;
+
+    uint32_t const previousGeneration = m_tileHeatMapsGeneration;
+    m_tileHeatMapsGeneration          = m_tileDirtyTracker.GetGeneration();
+
+    for (int tileY = dirtyMins.y; tileY <= dirtyMaxs.y; ++tileY)
     {
-        for (int x = 0; x < m_dimensions.x; ++x)
+        for (int tileX = dirtyMins.x; tileX <= dirtyMaxs.x; ++tileX)
         {
-            m_tiles.emplace_back();
+            bool const isSolid   = m_solidBits.IsSet(tileX, tileY);
+            bool const isWater   = m_waterBits.IsSet(tileX, tileY);
+            bool const isScorpio = m_scorpioBits.IsSet(tileX, tileY);
+
+            m_tileHeatMaps[1]->SetValue(tileX, tileY, !isSolid && !isScorpio ? 0 : DistanceField::UNREACHABLE);
+            m_tileHeatMaps[2]->SetValue(tileX, tileY, (!isSolid || isWater) && !isScorpio ? 0 : DistanceField::UNREACHABLE);
         }
     }
 
-    MapDefinition const* mapDef = MapDefinition::s_mapDefinitions[GetMapIndex()];
+    RepairDistanceField(*m_tileHeatMaps[0], m_startPosition, m_startPosition, previousGeneration, TILE_PASSABILITY_LAND);
+    RepairDistanceField(*m_tileHeatMaps[3], m_startPosition, m_startPosition, previousGeneration, TILE_PASSABILITY_LAND_AVOID_SCORPIO);
+}
 
-    GenerateTilesByType("Stone");
-    GenerateWormTiles(mapDef->GetWorm01TileName(), mapDef->GetWorm01Num(), mapDef->GetWorm01Length());
-    GenerateWormTiles(mapDef->GetWorm02TileName(), mapDef->GetWorm02Num(), mapDef->GetWorm02Length());
-    GenerateWormTiles(mapDef->GetWorm03TileName(), mapDef->GetWorm03Num(), mapDef->GetWorm03Length());
+//----------------------------------------------------------------------------------------------------
+// F7 captures land apart from curated snapshots; copying one out and naming it in MapDefinitions.xml
+// (snapshot="...") is the only way it replaces generation
+String Map::GetSnapshotCaptureFilePath() const
+{
+    return Stringf("Data/Maps/Captures/%s.snapshot", m_mapDef->GetName().c_str());
+}
 
-    GenerateTilesByType("Floor");
+//----------------------------------------------------------------------------------------------------
+// Writes tiles, start / exit, the debug heat maps and every living NPC, so LoadSnapshot can rebuild this
+// exact map without running generation. The player and any bullets / effects are not saved.
+bool Map::SaveSnapshot()
+{
+    CreateTileHeatMapsIfNeeded();
 
-    GenerateLShapeTiles(2, 2, 5, 5, false);
-    GenerateLShapeTiles(m_dimensions.x - 9, m_dimensions.y - 9, 7, 7, true);
-    GenerateStartPosTile();
-    GenerateExitPosTile();
+    String const filePath = GetSnapshotCaptureFilePath();
+    int const    numTiles = GetTileNums();
+
+    MapSnapshotHeader header;
+    header.m_tileDefinitionsHash = ComputeTileDefinitionsHash();
+    header.m_dimensionsX         = m_dimensions.x;
+    header.m_dimensionsY         = m_dimensions.y;
+    header.m_startX              = m_startPosition.x;
+    header.m_startY              = m_startPosition.y;
+    header.m_exitX               = m_exitPosition.x;
+    header.m_exitY               = m_exitPosition.y;
+    header.m_numHeatMaps         = static_cast<uint32_t>(m_tileHeatMaps.size());
 
-    if (!IsValidMap(IntVec2::ONE, m_exitPosition, 100))
+    std::vector<unsigned char> tileBytes(GetMapSnapshotTilesSize(numTiles), 0);
+    std::vector<uint16_t>      heatMapValues(static_cast<size_t>(numTiles) * m_tileHeatMaps.size());
+
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+        {
+            int const tileIndex = tileY * m_dimensions.x + tileX;
+
+            tileBytes[tileIndex] = m_tiles.GetTileTypeIndex(tileX, tileY);
+
+            for (size_t heatMapIndex = 0; heatMapIndex < m_tileHeatMaps.size(); ++heatMapIndex)
+            {
+                heatMapValues[heatMapIndex * numTiles + tileIndex] = m_tileHeatMaps[heatMapIndex]->GetValue(tileIndex);
+            }
+        }
+    }
+
+    std::vector<MapSnapshotSpawn> spawns;
+
+    for (Entity const* entity : m_allEntities)
     {
-        ERROR_AND_DIE("Failed to GenerateAllTiles!")
+        if (!entity || entity->m_isDead || entity->m_isGarbage) continue;
+        if (!IsAgent(entity) || entity->m_type == ENTITY_TYPE_PLAYER_TANK) continue;
+
+        MapSnapshotSpawn spawn;
+        spawn.m_type               = entity->m_type;
+        spawn.m_faction            = entity->m_faction;
+        spawn.m_positionX          = entity->m_position.x;
+        spawn.m_positionY          = entity->m_position.y;
+        spawn.m_orientationDegrees = entity->m_orientationDegrees;
+        spawns.push_back(spawn);
     }
 
-    TileHeatMap const heatMap(m_dimensions, 999.f);
-    PopulateDistanceField(heatMap, IntVec2::ONE, 999.f);
-    ConvertUnreachableTilesToSolid(heatMap, "Stone");
+    header.m_numSpawns = static_cast<uint32_t>(spawns.size());
+
+    std::vector<uint64_t> const emptyVisibilityWords;
+    std::vector<uint64_t> const& visibilityWords = IsVisibilityTableCurrent() ? m_visibilityTable.GetWords() : emptyVisibilityWords;
 
-    printf("( Map%d ) Finish | GenerateAllTiles\n", m_mapDef->GetIndex());
+    header.m_visibilityTableRadius   = visibilityWords.empty() ? 0 : m_visibilityTable.GetRadius();
+    header.m_numVisibilityTableWords = static_cast<uint32_t>(visibilityWords.size());
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(std::filesystem::path(filePath).parent_path(), errorCode);
+
+    FILE* file = nullptr;
+
+    if (fopen_s(&file, filePath.c_str(), "wb") != 0 || file == nullptr)
+    {
+        printf("WARNING: failed to write map snapshot \"%s\"\n", filePath.c_str());
+        return false;
+    }
+
+    bool const didWrite = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(tileBytes.data(), 1, tileBytes.size(), file) == tileBytes.size() &&
+                          fwrite(heatMapValues.data(), sizeof(uint16_t), heatMapValues.size(), file) == heatMapValues.size() &&
+                          fwrite(spawns.data(), sizeof(MapSnapshotSpawn), spawns.size(), file) == spawns.size() &&
+                          fwrite(visibilityWords.data(), sizeof(uint64_t), visibilityWords.size(), file) == visibilityWords.size();
+
+    bool const didClose = fclose(file) == 0;
+
+    // A truncated snapshot would fail LoadSnapshot's size check anyway; don't leave it behind
+    if (!didWrite || !didClose)
+    {
+        printf("WARNING: failed to write map snapshot \"%s\"\n", filePath.c_str());
+        std::filesystem::remove(filePath, errorCode);
+        return false;
+    }
+
+    printf("( Map%d ) Saved  | %s\n", m_mapDef->GetIndex(), filePath.c_str());
+
+    return true;
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::GenerateTilesByType(String const& tileName)
+// Reads the snapshot straight out of a mapped view. Returns false, leaving the map untouched, if the file
+// is missing or was saved for different dimensions, TileDefinitions or snapshot version.
+bool Map::LoadSnapshot(String const& filePath)
 {
+    MappedFileView view;
+
+    if (!view.Open(filePath.c_str())) return false;
+
+    MapSnapshotHeader header;
+
+    if (view.GetSize() < sizeof(header)) return false;
+
+    memcpy(&header, view.GetData(), sizeof(header));
+
+    int const     numTiles     = GetTileNums();
+    size_t const  tilesSize    = GetMapSnapshotTilesSize(numTiles);
+    size_t const  heatMapsSize = static_cast<size_t>(header.m_numHeatMaps) * numTiles * sizeof(uint16_t);
+    size_t const  spawnsSize   = static_cast<size_t>(header.m_numSpawns) * sizeof(MapSnapshotSpawn);
+    size_t const  tableSize    = static_cast<size_t>(header.m_numVisibilityTableWords) * sizeof(uint64_t);
+    IntVec2 const startCoords  = IntVec2(header.m_startX, header.m_startY);
+    IntVec2 const exitCoords   = IntVec2(header.m_exitX, header.m_exitY);
+
+    if (header.m_magic != MAP_SNAPSHOT_MAGIC ||
+        header.m_version != MAP_SNAPSHOT_VERSION ||
+        header.m_tileDefinitionsHash != ComputeTileDefinitionsHash() ||
+        header.m_dimensionsX != m_dimensions.x ||
+        header.m_dimensionsY != m_dimensions.y ||
+        header.m_numHeatMaps > 4 ||
+        header.m_visibilityTableRadius < 0 ||
+        header.m_visibilityTableRadius > MAX_VISIBILITY_TABLE_RADIUS ||
+        view.GetSize() != sizeof(header) + tilesSize + heatMapsSize + spawnsSize + tableSize ||
+        IsTileCoordsOutOfBounds(startCoords) ||
+        IsTileCoordsOutOfBounds(exitCoords))
+    {
+        printf("( Map%d ) Stale  | %s, regenerating\n", m_mapDef->GetIndex(), filePath.c_str());
+        return false;
+    }
+
+    TileTypeIndex const* tileTypeIndices = reinterpret_cast<TileTypeIndex const*>(view.GetData() + sizeof(header));
+    unsigned char const* heatMapBytes    = view.GetData() + sizeof(header) + tilesSize;
+    unsigned char const* spawnBytes      = view.GetData() + sizeof(header) + tilesSize + heatMapsSize;
+    unsigned char const* tableBytes      = view.GetData() + sizeof(header) + tilesSize + heatMapsSize + spawnsSize;
+    size_t const         numTileDefs     = TileDefinition::s_tileDefinitions.size();
+
+    for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+    {
+        if (tileTypeIndices[tileIndex] >= numTileDefs) return false;
+    }
+
+    printf("( Map%d ) Start  | LoadSnapshot\n", m_mapDef->GetIndex());
+
+    m_startPosition = startCoords;
+    m_exitPosition  = exitCoords;
+
+    FillAllTiles(m_stoneTileTypeIndex);
+
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+        {
+            SetTileAtCoords(tileTypeIndices[tileY * m_dimensions.x + tileX], tileX, tileY);
+        }
+    }
+
+    m_tiles.Compact();
+
+    // A table saved with another radius is left for BuildVisibilityTableIfNeeded to replace
+    if (header.m_visibilityTableRadius > 0 && header.m_visibilityTableRadius == m_visibilityTableRadius)
+    {
+        m_visibilityTable.Load(GetRayBlockedBits(), header.m_visibilityTableRadius, tableBytes, header.m_numVisibilityTableWords);
+        m_visibilityTableGeneration = m_tileDirtyTracker.GetGeneration();
+    }
+
+    // Only take the heat maps if the full set is there; otherwise F6 rebuilds them on demand
+    if (header.m_numHeatMaps == 4)
+    {
+        for (uint32_t heatMapIndex = 0; heatMapIndex < header.m_numHeatMaps; ++heatMapIndex)
+        {
+            DistanceField* field = m_distanceFieldPool.Acquire();
+
+            memcpy(field->GetData(), heatMapBytes + static_cast<size_t>(heatMapIndex) * numTiles * sizeof(uint16_t), numTiles * sizeof(uint16_t));
+            m_tileHeatMaps.push_back(field);
+        }
+
+        m_tileHeatMapsGeneration = m_tileDirtyTracker.GetGeneration();
+    }
+
+    // Entities are created later by SpawnInitialEntities, since this may be running on a worker thread
+    m_snapshotSpawns.clear();
+    m_snapshotSpawns.reserve(header.m_numSpawns);
+
+    for (uint32_t spawnIndex = 0; spawnIndex < header.m_numSpawns; ++spawnIndex)
+    {
+        MapSnapshotSpawn spawn;
+        memcpy(&spawn, spawnBytes + spawnIndex * sizeof(MapSnapshotSpawn), sizeof(spawn));
+
+        if (spawn.m_type != ENTITY_TYPE_SCORPIO &&
+            spawn.m_type != ENTITY_TYPE_LEO &&
+            spawn.m_type != ENTITY_TYPE_ARIES)
+            continue;
+
+        if (spawn.m_faction < 0 || spawn.m_faction >= NUM_ENTITY_FACTIONS) continue;
+
+        m_snapshotSpawns.push_back(spawn);
+    }
+
+    printf("( Map%d ) Finish | LoadSnapshot\n", m_mapDef->GetIndex());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rolls layouts until the exit is reachable from the start, then seals off every open pocket the
+// player can never reach. Each attempt costs one linear connectivity pass instead of a distance field.
+void Map::GenerateAllTiles()
+{
+    printf("( Map%d ) Start  | GenerateAllTiles\n", m_mapDef->GetIndex());
+
+    constexpr int maxAttempts = 100;
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt)
+    {
+        GenerateTileLayout();
+
+        if (!IsValidMap()) continue;
+
+        ConvertUnreachableTilesToSolid(m_stoneTileTypeIndex);
+        m_tiles.Compact();
+
+        printf("( Map%d ) Finish | GenerateAllTiles ( attempt %d, %d / %d chunks allocated )\n", m_mapDef->GetIndex(), attempt + 1, m_tiles.GetNumAllocatedChunks(), m_tiles.GetNumChunks());
+        return;
+    }
+
+    ERROR_AND_DIE("Failed to generate a valid map after maximum attempts!")
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::GenerateTileLayout()
+{
+    MapDefinition const* mapDef = MapDefinition::s_mapDefinitions[GetMapIndex()];
+
+    GenerateTilesByType(m_stoneTileTypeIndex);
+    GenerateWormTiles(mapDef->GetWorm01TileTypeIndex(), mapDef->GetWorm01Num(), mapDef->GetWorm01Length());
+    GenerateWormTiles(mapDef->GetWorm02TileTypeIndex(), mapDef->GetWorm02Num(), mapDef->GetWorm02Length());
+    GenerateWormTiles(mapDef->GetWorm03TileTypeIndex(), mapDef->GetWorm03Num(), mapDef->GetWorm03Length());
+
+    GenerateTilesByType(m_floorTileTypeIndex);
+
+    GenerateLShapeTiles(2, 2, 5, 5, false);
+    GenerateLShapeTiles(m_dimensions.x - 9, m_dimensions.y - 9, 7, 7, true);
+    GenerateStartPosTile();
+    GenerateExitPosTile();
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::GenerateTilesByType(TileTypeIndex const tileTypeIndex)
+{
+    // Stone covers everything the Floor pass does not carve out, so start from whole uniform Stone chunks
+    // and let Floor overwrite the L-shapes afterwards; only the chunks that differ get allocated
+    if (tileTypeIndex == m_stoneTileTypeIndex)
+    {
+        FillAllTiles(tileTypeIndex);
+        return;
+    }
+
     for (int y = 0; y < m_dimensions.y; ++y)
     {
         for (int x = 0; x < m_dimensions.x; ++x)
         {
-            if (tileName == "Floor")
+            if (tileTypeIndex == m_floorTileTypeIndex)
             {
                 if (!IsEdgeTile(x, y) &&
                     IsTileCoordsInLShape(x, y))
                 {
-                    SetTileAtCoords(tileName, x, y);
-                }
-            }
-
-            if (tileName == "Stone")
-            {
-                if (IsEdgeTile(x, y) ||
-                    !IsTileCoordsInLShape(x, y))
-                {
-                    SetTileAtCoords(tileName, x, y);
+                    SetTileAtCoords(tileTypeIndex, x, y);
                 }
             }
         }
@@ -477,7 +898,7 @@ void Map::GenerateTilesByType(String const& tileName)
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::GenerateWormTiles(String const& wormTileName, int const numWorms, int const wormLength)
+void Map::GenerateWormTiles(TileTypeIndex const wormTileTypeIndex, int const numWorms, int const wormLength)
 {
     for (int i = 0; i < numWorms; ++i)
     {
@@ -485,7 +906,7 @@ void Map::GenerateWormTiles(String const& wormTileName, int const numWorms, int
 
         if (!IsEdgeTile(wormPosition.x, wormPosition.y))
         {
-            SetTileAtCoords(wormTileName, wormPosition.x, wormPosition.y);
+            SetTileAtCoords(wormTileTypeIndex, wormPosition.x, wormPosition.y);
         }
 
         for (int j = 0; j < wormLength; ++j)
@@ -497,7 +918,7 @@ void Map::GenerateWormTiles(String const& wormTileName, int const numWorms, int
                 !IsEdgeTile(newPosition.x, newPosition.y))
             {
                 wormPosition = newPosition;
-                SetTileAtCoords(wormTileName, wormPosition.x, wormPosition.y);
+                SetTileAtCoords(wormTileTypeIndex, wormPosition.x, wormPosition.y);
             }
         }
     }
@@ -518,14 +939,14 @@ void Map::GenerateLShapeTiles(int const  tileCoordX,
             {
                 if (y == 0 || x == 0)
                 {
-                    SetTileAtCoords("Stone", tileCoordX + x, tileCoordY + y);
+                    SetTileAtCoords(m_stoneTileTypeIndex, tileCoordX + x, tileCoordY + y);
                 }
             }
             else
             {
                 if (y == height - 1 || x == width - 1)
                 {
-                    SetTileAtCoords("Stone", tileCoordX + x, tileCoordY + y);
+                    SetTileAtCoords(m_stoneTileTypeIndex, tileCoordX + x, tileCoordY + y);
                 }
             }
         }
@@ -535,37 +956,67 @@ void Map::GenerateLShapeTiles(int const  tileCoordX,
 //----------------------------------------------------------------------------------------------------
 void Map::GenerateStartPosTile()
 {
-    SetTileAtCoords("Start", m_startPosition.x, m_startPosition.y);
+    SetTileAtCoords(m_startTileTypeIndex, m_startPosition.x, m_startPosition.y);
 }
 
 //----------------------------------------------------------------------------------------------------
 void Map::GenerateExitPosTile()
 {
-    SetTileAtCoords("Exit", m_exitPosition.x, m_exitPosition.y);
+    SetTileAtCoords(m_exitTileTypeIndex, m_exitPosition.x, m_exitPosition.y);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::FillAllTiles(TileTypeIndex const tileTypeIndex)
+{
+    m_tiles.FillAll(tileTypeIndex);
+    m_tileDirtyTracker.MarkAllDirty();
+
+    unsigned char const tileFlags = TileDefinition::s_tileFlags[tileTypeIndex];
+    m_solidBits.FillAll((tileFlags & TILE_FLAG_SOLID) != 0);
+    m_waterBits.FillAll((tileFlags & TILE_FLAG_WATER) != 0);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::SetTileAtCoords(String const& tileName, int const tileX, int const tileY)
+void Map::SetTileAtCoords(TileTypeIndex const tileTypeIndex, int const tileX, int const tileY)
 {
-    int const tileIndex = tileY * m_dimensions.x + tileX;
+    // The bitboards always mirror the tile types, so an unchanged type has nothing to update
+    if (m_tiles.GetTileTypeIndex(tileX, tileY) == tileTypeIndex) return;
+
+    m_tiles.SetTileTypeIndex(tileX, tileY, tileTypeIndex);
+    m_tileDirtyTracker.MarkDirty(tileX, tileY);
+
+    unsigned char const tileFlags = TileDefinition::s_tileFlags[tileTypeIndex];
+    m_solidBits.SetTo(tileX, tileY, (tileFlags & TILE_FLAG_SOLID) != 0);
+    m_waterBits.SetTo(tileX, tileY, (tileFlags & TILE_FLAG_WATER) != 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runtime entry point for destructible / mutable terrain. Render meshes and heat maps pick the
+// change up through the dirty tracker; the bitboards are updated immediately.
+bool Map::ChangeTileAtCoords(IntVec2 const& tileCoords, TileTypeIndex const tileTypeIndex)
+{
+    if (IsTileCoordsOutOfBounds(tileCoords)) return false;
+    if (tileTypeIndex >= TileDefinition::s_tileDefinitions.size()) return false;
+
+    SetTileAtCoords(tileTypeIndex, tileCoords.x, tileCoords.y);
 
-    m_tiles[tileIndex].m_coords = IntVec2(tileX, tileY);
-    m_tiles[tileIndex].m_name   = tileName;
+    return true;
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::ConvertUnreachableTilesToSolid(TileHeatMap const& heatMap, String const& tileName)
+// Relies on m_tileConnectivity built by IsValidMap for the current layout
+void Map::ConvertUnreachableTilesToSolid(TileTypeIndex const solidTileTypeIndex)
 {
+    int const startRegionId = m_tileConnectivity.GetRegionId(m_startPosition);
+
     for (int y = 0; y < m_dimensions.y; ++y)
     {
         for (int x = 0; x < m_dimensions.x; ++x)
         {
-            IntVec2 tileCoords(x, y);
-
-            if (!IsTileSolid(tileCoords) &&
-                heatMap.GetValueAtCoords(IntVec2(x, y)) == 999.f)
+            if (!m_solidBits.IsSet(x, y) &&
+                m_tileConnectivity.GetRegionId(x, y) != startRegionId)
             {
-                SetTileAtCoords(tileName, x, y);
+                SetTileAtCoords(solidTileTypeIndex, x, y);
             }
         }
     }
@@ -613,422 +1064,676 @@ bool Map::IsWorldPosOccupied(Vec2 const& position) const
     return false;
 }
 
-bool Map::IsWorldPosOccupiedByEntity(Vec2 const& position, EntityType const type) const
+//----------------------------------------------------------------------------------------------------
+// Valid when the exit can be walked to from the start
+bool Map::IsValidMap()
 {
-    for (int entityIndex = 0; entityIndex < static_cast<int>(m_allEntities.size()); ++entityIndex)
+    m_tileConnectivity.Build(m_solidBits, m_waterBits);
+
+    return m_tileConnectivity.AreConnected(m_startPosition, m_exitPosition);
+}
+
+
+//----------------------------------------------------------------------------------------------------
+AABB2 const Map::GetTileBounds(IntVec2 const& tileCoords) const
+{
+    if (IsTileCoordsOutOfBounds(tileCoords))
+        ERROR_AND_DIE("tileCoords is out of bound")
+
+    float const minsX = static_cast<float>(tileCoords.x);
+    float const minsY = static_cast<float>(tileCoords.y);
+    Vec2 const  mins(minsX, minsY);
+    Vec2 const  maxs(mins + Vec2::ONE);
+
+    return AABB2(mins, maxs);
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB2 const Map::GetTileBounds(int const tileIndex) const
+{
+    if (tileIndex < 0 || tileIndex >= GetTileNums())
+        ERROR_AND_DIE("tileIndex is out of bound")
+
+    int const     tileX = tileIndex % m_dimensions.x;
+    int const     tileY = tileIndex / m_dimensions.x;
+    IntVec2 const tileCoords(tileX, tileY);
+
+    return GetTileBounds(tileCoords);
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 Map::RollRandomTileCoords()
+{
+    int const randomX = m_generationRng.RollRandomIntInRange(0, m_dimensions.x - 1);
+    int const randomY = m_generationRng.RollRandomIntInRange(0, m_dimensions.y - 1);
+
+    return IntVec2(randomX, randomY);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Uniform over the tiles startCoords can reach under passability, which must be LAND_AVOID_SCORPIO or
+// AMPHIBIAN. Off the matching region index unless startCoords itself is blocked (e.g. a Scorpio stepped
+// onto it), which takes the flood as before.
+IntVec2 Map::RollRandomTraversableTileCoords(IntVec2 const& startCoords, TilePassability const passability) const
+{
+    SyncWanderRegionIndices();
+
+    TileRegionIndex const& regionIndex = passability == TILE_PASSABILITY_AMPHIBIAN ? m_amphibianWanderRegionIndex : m_landWanderRegionIndex;
+    int const              regionId    = IsTileCoordsOutOfBounds(startCoords) ? TileRegionIndex::NO_REGION : regionIndex.GetRegionId(startCoords);
+
+    if (regionId != TileRegionIndex::NO_REGION)
     {
-        // Check if the position matches
-        if (m_allEntities[entityIndex]->m_position == position)
+        int const tileSlot = g_rng->RollRandomIntInRange(0, regionIndex.GetRegionSize(regionId) - 1);
+
+        return regionIndex.GetRegionTile(regionId, tileSlot);
+    }
+
+    // 先填充距離場
+    DistanceField& field = *m_scratchDistanceField;
+
+    PopulateDistanceField(field, startCoords, passability);
+    BuildBlockedBits(passability, m_blockedBits);
+
+    // 儲存可到達的座標
+    std::vector<IntVec2> traversableCoords;
+
+    // 遍歷整個地圖的每個座標
+    for (int y = 0; y < m_dimensions.y; ++y)
+    {
+        for (int x = 0; x < m_dimensions.x; ++x)
         {
-            // Optionally filter by entity type
-            if (m_allEntities[entityIndex]->m_type == type)
+            IntVec2 currentCoords(x, y);
+
+            // 檢查該座標是否可到達
+            if (m_blockedBits.IsSet(currentCoords) ||
+                !field.IsReachable(currentCoords))
+                continue;
+
+            traversableCoords.push_back(currentCoords);
+        }
+    }
+
+    // 如果沒有可到達的座標，回傳一個無效座標或進行處理
+    if (traversableCoords.empty())
+    {
+        ERROR_AND_DIE("No traversable tiles found!");
+    }
+
+    // 從可到達的座標中隨機選擇一個
+    int randomIndex = g_rng->RollRandomIntInRange(0, static_cast<int>(traversableCoords.size() - 1));
+    return traversableCoords[randomIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 Map::RollRandomCardinalDirection()
+{
+    switch (m_generationRng.RollRandomIntInRange(0, 3))
+    {
+    case 0:
+        return IntVec2(0, 1);
+    case 1:
+        return IntVec2(1, 0);
+    case 2:
+        return IntVec2(0, -1);
+    case 3:
+        return IntVec2(-1, 0);
+    }
+    return IntVec2::ZERO;
+}
+
+//----------------------------------------------------------------------------------------------------
+// One BFS from startCoords; tiles it cannot reach are UNREACHABLE. The start tile itself is always 0.
+void Map::PopulateDistanceField(DistanceField& field, IntVec2 const& startCoords, TilePassability const passability) const
+{
+    BuildBlockedBits(passability, m_blockedBits);
+    m_tileFloodFill.Run(field, m_blockedBits, startCoords);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::PopulateDistanceField(DistanceField& field, IntVec2 const& startCoords) const
+{
+    PopulateDistanceField(field, startCoords, TILE_PASSABILITY_LAND);
+}
+
+//----------------------------------------------------------------------------------------------------
+// field must hold the distances from oldStartCoords as they were at fieldGeneration. Only the tiles the
+// dirty tracker reports since then, plus whatever their distances depend on, are revisited. A large dirty
+// rect (e.g. after FillAllTiles) is cheaper to rebuild outright.
+void Map::RepairDistanceField(DistanceField&        field,
+                              IntVec2 const&        oldStartCoords,
+                              IntVec2 const&        newStartCoords,
+                              uint32_t const        fieldGeneration,
+                              TilePassability const passability) const
+{
+    if (IsTileCoordsOutOfBounds(oldStartCoords) || IsTileCoordsOutOfBounds(newStartCoords))
+    {
+        PopulateDistanceField(field, newStartCoords, passability);
+        return;
+    }
+
+    IntVec2 dirtyMins = IntVec2::ONE;    // Empty rect unless the tracker reports one
+    IntVec2 dirtyMaxs = IntVec2::ZERO;
+
+    if (m_tileDirtyTracker.GetDirtyRectSince(fieldGeneration, dirtyMins, dirtyMaxs))
+    {
+        int const dirtyArea = (dirtyMaxs.x - dirtyMins.x + 1) * (dirtyMaxs.y - dirtyMins.y + 1);
+
+        if (dirtyArea * 4 > GetTileNums())
+        {
+            PopulateDistanceField(field, newStartCoords, passability);
+            return;
+        }
+    }
+
+    BuildBlockedBits(passability, m_blockedBits);
+    m_tileFloodFill.Repair(field, m_blockedBits, oldStartCoords, newStartCoords, dirtyMins, dirtyMaxs);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::PopulateDistanceFieldForEntity(DistanceField& field, IntVec2 const& startCoords) const
+{
+    PopulateDistanceField(field, startCoords, TILE_PASSABILITY_LAND_AVOID_SCORPIO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Marks every tile that is neither solid nor holding a Scorpio
+void Map::PopulateDistanceFieldForLandBased(DistanceField& field) const
+{
+    PopulatePassabilityMap(field, TILE_PASSABILITY_LAND_AVOID_SCORPIO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same as land-based, except water counts as open
+void Map::PopulateDistanceFieldForAmphibian(DistanceField& field) const
+{
+    PopulatePassabilityMap(field, TILE_PASSABILITY_AMPHIBIAN);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Water tiles are solid, so "not solid, no Scorpio" is the same rule PopulateDistanceFieldForEntity uses
+void Map::PopulateDistanceFieldToPosition(DistanceField& field, IntVec2 const& playerCoords) const
+{
+    PopulateDistanceField(field, playerCoords, TILE_PASSABILITY_LAND_AVOID_SCORPIO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Combines the tile bitboards into one "can't enter" mask, a 64-tile word at a time. Padding bits stay
+// zero because every source board keeps them zero.
+void Map::BuildBlockedBits(TilePassability const passability, TileBitboard& out_blockedBits) const
+{
+    if (out_blockedBits.GetDimensions() != m_dimensions)
+    {
+        out_blockedBits.Resize(m_dimensions);
+    }
+
+    int const wordsPerRow = m_solidBits.GetWordsPerRow();
+
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        uint64_t const* solidRow   = m_solidBits.GetRow(tileY);
+        uint64_t const* waterRow   = m_waterBits.GetRow(tileY);
+        uint64_t const* scorpioRow = m_scorpioBits.GetRow(tileY);
+        uint64_t*       blockedRow = out_blockedBits.GetRow(tileY);
+
+        for (int wordIndex = 0; wordIndex < wordsPerRow; ++wordIndex)
+        {
+            switch (passability)
             {
-                return true;
+            case TILE_PASSABILITY_LAND:
+                blockedRow[wordIndex] = solidRow[wordIndex] | waterRow[wordIndex];
+                break;
+            case TILE_PASSABILITY_LAND_AVOID_SCORPIO:
+                blockedRow[wordIndex] = solidRow[wordIndex] | waterRow[wordIndex] | scorpioRow[wordIndex];
+                break;
+            case TILE_PASSABILITY_AMPHIBIAN:
+                blockedRow[wordIndex] = (solidRow[wordIndex] & ~waterRow[wordIndex]) | scorpioRow[wordIndex];
+                break;
+            case TILE_PASSABILITY_ANY_TERRAIN:
+                blockedRow[wordIndex] = solidRow[wordIndex] & ~waterRow[wordIndex];
+                break;
+            default:
+                ERROR_AND_DIE("Unknown TilePassability!")
             }
         }
     }
+}
+
+//----------------------------------------------------------------------------------------------------
+// 0 on every open tile, UNREACHABLE on the rest
+void Map::PopulatePassabilityMap(DistanceField& field, TilePassability const passability) const
+{
+    BuildBlockedBits(passability, m_blockedBits);
+    field.FillAll(DistanceField::UNREACHABLE);
+
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        uint64_t const* blockedRow = m_blockedBits.GetRow(tileY);
+
+        for (int wordIndex = 0; wordIndex < m_blockedBits.GetWordsPerRow(); ++wordIndex)
+        {
+            uint64_t openBits = ~blockedRow[wordIndex] & m_blockedBits.GetValidBitsMask(wordIndex);
+
+            while (openBits != 0)
+            {
+                int const tileX = (wordIndex << 6) + std::countr_zero(openBits);
+
+                field.SetValue(tileX, tileY, 0);
+                openBits &= openBits - 1;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<Vec2> Map::GenerateEntityPathToGoal(DistanceField& field, Vec2 const& start, Vec2 const& goal) const
+{
+    PopulateDistanceFieldToPosition(field, GetTileCoordsFromWorldPos(goal));
+
+    return GenerateEntityPathAlongField(field, start, goal);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks downhill from start until the goal tile; the path comes back goal-first so callers pop from the
+// back. Stops early if start cannot reach the goal, instead of looping on an unreachable tile.
+std::vector<Vec2> Map::GenerateEntityPathAlongField(DistanceField const& field, Vec2 const& start, Vec2 const& goal) const
+{
+    IntVec2 const     goalCoords    = GetTileCoordsFromWorldPos(goal);
+    IntVec2           currentCoords = GetTileCoordsFromWorldPos(start);
+    std::vector<Vec2> path;
+
+    while (currentCoords != goalCoords)
+    {
+        path.push_back(GetWorldPosFromTileCoords(currentCoords));
+
+        IntVec2  bestNeighbor   = currentCoords;
+        uint16_t lowestDistance = field.GetValue(currentCoords);
+
+        for (IntVec2 const& offset : {IntVec2(-1, 0), IntVec2(1, 0), IntVec2(0, -1), IntVec2(0, 1)})
+        {
+            IntVec2 const neighbor = currentCoords + offset;
+
+            if (IsTileCoordsOutOfBounds(neighbor)) continue;
+
+            uint16_t const distance = field.GetValue(neighbor);
+
+            if (distance < lowestDistance)
+            {
+                lowestDistance = distance;
+                bestNeighbor   = neighbor;
+            }
+        }
+
+        if (bestNeighbor == currentCoords) break;
+
+        currentCoords = bestNeighbor;
+    }
 
-    return false;
+    path.push_back(goal);
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
-bool Map::IsValidMap(IntVec2 const& startCoords, IntVec2 const& exitCoords, int const maxAttempts)
+//----------------------------------------------------------------------------------------------------
+// Same path format as GenerateEntityPathToGoal (goal first, start tile last), but from one A* search
+// instead of a whole-map flood. An unreachable goal gives the same straight-line fallback as well.
+// Long paths between open tiles plan on the cluster graph instead; heuristic only picks how the
+// direct search estimates.
+std::vector<Vec2> Map::FindEntityPathToGoal(Vec2 const&           start,
+                                            Vec2 const&           goal,
+                                            TilePassability const passability,
+                                            PathHeuristic const   heuristic) const
 {
-    for (int attempt = 0; attempt < maxAttempts; ++attempt)
-    {
-        TileHeatMap heatMap(m_dimensions, 999.f);
-        PopulateDistanceField(heatMap, startCoords, 999.f);
+    IntVec2 const startCoords = GetTileCoordsFromWorldPos(start);
+    IntVec2 const goalCoords  = GetTileCoordsFromWorldPos(goal);
 
-        if (heatMap.GetValueAtCoords(exitCoords) != 999.f)
-        {
-            return true;
-        }
+    if (heuristic == PATH_HEURISTIC_LANDMARKS) BuildPathLandmarksIfStale();
 
-        GenerateAllTiles();
+    BuildBlockedBits(passability, m_blockedBits);
+
+    int const  pathSpan       = std::abs(goalCoords.x - startCoords.x) + std::abs(goalCoords.y - startCoords.y);
+    bool const isHierarchical = pathSpan >= HIERARCHICAL_PATH_MIN_DISTANCE &&
+                                !IsTileCoordsOutOfBounds(startCoords) && !IsTileCoordsOutOfBounds(goalCoords) &&
+                                !m_blockedBits.IsSet(startCoords) && !m_blockedBits.IsSet(goalCoords);
+
+    if (isHierarchical)
+    {
+        RefreshClusterGraph(passability, m_blockedBits).FindPath(m_blockedBits, startCoords, goalCoords, m_tilePath);
+    }
+    else
+    {
+        m_tilePathfinder.FindPath(m_blockedBits, startCoords, goalCoords, heuristic, m_tilePath);
     }
 
-    ERROR_AND_DIE("Failed to generate a valid map after maximum attempts!")
+    return MakeEntityPathFromTiles(m_tilePath, startCoords, goal);
 }
 
-
 //----------------------------------------------------------------------------------------------------
-AABB2 const Map::GetTileBounds(IntVec2 const& tileCoords) const
+// Jump Point Search mode: 8-connected, with waypoints only where the path turns, so movers pop and
+// raycast far less. Spans in cluster-graph range still take FindEntityPathToGoal.
+std::vector<Vec2> Map::FindEntityJumpPointPathToGoal(Vec2 const& start, Vec2 const& goal, TilePassability const passability) const
 {
-    if (IsTileCoordsOutOfBounds(tileCoords))
-        ERROR_AND_DIE("tileCoords is out of bound")
+    IntVec2 const startCoords = GetTileCoordsFromWorldPos(start);
+    IntVec2 const goalCoords  = GetTileCoordsFromWorldPos(goal);
+    int const     pathSpan    = std::abs(goalCoords.x - startCoords.x) + std::abs(goalCoords.y - startCoords.y);
 
-    float const minsX = static_cast<float>(tileCoords.x);
-    float const minsY = static_cast<float>(tileCoords.y);
-    Vec2 const  mins(minsX, minsY);
-    Vec2 const  maxs(mins + Vec2::ONE);
+    if (pathSpan >= HIERARCHICAL_PATH_MIN_DISTANCE) return FindEntityPathToGoal(start, goal, passability, PATH_HEURISTIC_LANDMARKS);
 
-    return AABB2(mins, maxs);
+    BuildBlockedBits(passability, m_blockedBits);
+    m_tilePathfinder.FindJumpPointPath(m_blockedBits, startCoords, goalCoords, m_tilePath);
+
+    return MakeEntityPathFromTiles(m_tilePath, startCoords, goal);
 }
 
 //----------------------------------------------------------------------------------------------------
-AABB2 const Map::GetTileBounds(int const tileIndex) const
+// tilePath runs start to goal, or is empty when the goal is unreachable. The goal tile itself is left
+// out; the exact goal position stands in for it.
+std::vector<Vec2> Map::MakeEntityPathFromTiles(std::vector<IntVec2> const& tilePath, IntVec2 const& startCoords, Vec2 const& goal) const
 {
-    if (tileIndex < 0 || tileIndex >= static_cast<int>(m_tiles.size()))
-        ERROR_AND_DIE("tileIndex is out of bound")
+    std::vector<Vec2> path;
 
-    int const     tileX = tileIndex % m_dimensions.x;
-    int const     tileY = tileIndex / m_dimensions.x;
-    IntVec2 const tileCoords(tileX, tileY);
+    path.reserve(tilePath.size() + 1);
+    path.push_back(goal);
 
-    return GetTileBounds(tileCoords);
+    if (tilePath.empty())
+    {
+        if (startCoords != GetTileCoordsFromWorldPos(goal)) path.push_back(GetWorldPosFromTileCoords(startCoords));
+
+        return path;
+    }
+
+    for (int tileIndex = static_cast<int>(tilePath.size()) - 2; tileIndex >= 0; --tileIndex)
+    {
+        path.push_back(GetWorldPosFromTileCoords(tilePath[tileIndex]));
+    }
+
+    return path;
 }
 
 //----------------------------------------------------------------------------------------------------
-IntVec2 Map::RollRandomTileCoords() const
+PathRequestHandle Map::RequestEntityPath(PathRequestHandle const pendingHandle, PathRequest const& request)
 {
-    int const randomX = g_rng->RollRandomIntInRange(0, m_dimensions.x - 1);
-    int const randomY = g_rng->RollRandomIntInRange(0, m_dimensions.y - 1);
-
-    return IntVec2(randomX, randomY);
+    return m_pathRequestQueue.Submit(pendingHandle, request);
 }
 
 //----------------------------------------------------------------------------------------------------
-IntVec2 Map::RollRandomTraversableTileCoords(TileHeatMap const& heatMap, IntVec2 const& startCoords) const
+bool Map::TakeEntityPathResult(PathRequestHandle const handle, std::vector<Vec2>& out_path)
 {
-    // 先填充距離場
-    PopulateDistanceFieldForEntity(heatMap, startCoords, 999.f);
+    return m_pathRequestQueue.TakeResult(handle, out_path);
+}
 
-    // 儲存可到達的座標
-    std::vector<IntVec2> traversableCoords;
+//----------------------------------------------------------------------------------------------------
+// Oldest requests first. The first one is always solved, so a budget smaller than a single solve still
+// drains the queue; anything left waits for the next frame.
+void Map::ServicePathRequests()
+{
+    double const deadlineSeconds = GetCurrentTimeSeconds() + m_pathRequestBudgetSeconds;
+    PathRequest  request;
 
-    // 遍歷整個地圖的每個座標
-    for (int y = 0; y < m_dimensions.y; ++y)
+    do
     {
-        for (int x = 0; x < m_dimensions.x; ++x)
-        {
-            IntVec2 currentCoords(x, y);
-
-            // 檢查該座標是否可到達
-            if (IsTileSolid(currentCoords) ||
-                IsWorldPosOccupiedByEntity(Vec2(x, y) + Vec2(0.5f, 0.5f), ENTITY_TYPE_SCORPIO) ||
-                heatMap.GetValueAtCoords(currentCoords) == 999.f)
-                continue;
-
-            traversableCoords.push_back(currentCoords);
-        }
-    }
+        if (!m_pathRequestQueue.PopPending(request)) break;
 
-    // 如果沒有可到達的座標，回傳一個無效座標或進行處理
-    if (traversableCoords.empty())
-    {
-        ERROR_AND_DIE("No traversable tiles found!");
+        std::vector<Vec2> path = SolvePathRequest(request);
+        m_pathRequestQueue.Complete(request.m_handle, path);
     }
-
-    // 從可到達的座標中隨機選擇一個
-    int randomIndex = g_rng->RollRandomIntInRange(0, static_cast<int>(traversableCoords.size() - 1));
-    return traversableCoords[randomIndex];
+    while (GetCurrentTimeSeconds() < deadlineSeconds);
 }
 
 //----------------------------------------------------------------------------------------------------
-IntVec2 Map::RollRandomCardinalDirection() const
+// Chasing reads the shared per-goal flow field; a wandering goal is per entity, so one search is cheaper
+std::vector<Vec2> Map::SolvePathRequest(PathRequest const& request)
 {
-    switch (g_rng->RollRandomIntInRange(0, 3))
+    if (!request.m_isChasing)
     {
-    case 0:
-        return IntVec2(0, 1);
-    case 1:
-        return IntVec2(1, 0);
-    case 2:
-        return IntVec2(0, -1);
-    case 3:
-        return IntVec2(-1, 0);
+        return FindEntityJumpPointPathToGoal(request.m_start, request.m_goal, request.m_passability);
     }
-    return IntVec2::ZERO;
+
+    DistanceField const& flowField = GetFlowFieldToGoal(GetTileCoordsFromWorldPos(request.m_goal), request.m_passability);
+
+    return GenerateEntityPathAlongField(flowField, request.m_start, request.m_goal);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::GenerateHeatMaps(TileHeatMap const& heatMap) const
+// blockedBits must be BuildBlockedBits(passability); tiles changed since the last refresh are patched in
+TileClusterGraph& Map::RefreshClusterGraph(TilePassability const passability, TileBitboard const& blockedBits) const
 {
-    printf("( Map%d ) Start  | GenerateHeatMaps\n", m_mapDef->GetIndex());
+    TileClusterGraph& graph = m_clusterGraphs[passability];
+    IntVec2           dirtyMins;
+    IntVec2           dirtyMaxs;
 
-    for (int y = 0; y < m_dimensions.y; ++y)
+    if (!graph.IsBuilt())
     {
-        for (int x = 0; x < m_dimensions.x; ++x)
-        {
-            IntVec2 tileCoords(x, y);
-
-            if (IsTileSolid(tileCoords))
-            {
-                heatMap.SetValueAtCoords(tileCoords, 999.f);
-            }
-        }
+        graph.Build(blockedBits);
+    }
+    else if (m_tileDirtyTracker.GetDirtyRectSince(m_clusterGraphGenerations[passability], dirtyMins, dirtyMaxs))
+    {
+        graph.Update(blockedBits, dirtyMins, dirtyMaxs);
     }
 
-    printf("( Map%d ) Finish | GenerateHeatMaps\n", m_mapDef->GetIndex());
+    m_clusterGraphGenerations[passability] = m_tileDirtyTracker.GetGeneration();
+
+    return graph;
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::PopulateDistanceField(TileHeatMap const& heatMap, IntVec2 const& startCoords, float const specialValue) const
+// Patches the tiles in the dirty rect whose blocked state no longer matches either index; a large rect
+// (FillAllTiles, a loaded snapshot) rebuilds both outright
+void Map::SyncWanderRegionIndices() const
 {
-    // printf("( Map%d ) Start  | GenerateDistanceField\n", m_mapDef->GetIndex());
+    uint32_t const tileGeneration = m_tileDirtyTracker.GetGeneration();
+    IntVec2        dirtyMins;
+    IntVec2        dirtyMaxs;
+
+    if (m_landWanderRegionIndex.IsBuilt() && m_wanderRegionGeneration == tileGeneration) return;
 
-    heatMap.SetValueAtAllTiles(specialValue);
-    heatMap.SetValueAtCoords(startCoords, 0.f);
+    bool const hasDirtyRect = m_landWanderRegionIndex.IsBuilt() && m_tileDirtyTracker.GetDirtyRectSince(m_wanderRegionGeneration, dirtyMins, dirtyMaxs);
 
-    float currentSearchValue = 0.f;
-    bool  isStillGoing       = true;
+    m_wanderRegionGeneration = tileGeneration;
 
-    while (isStillGoing)    // For each pass, assume we're done UNLESS something changes
+    if (hasDirtyRect)
     {
-        isStillGoing = false;
+        dirtyMins = IntVec2(std::max(dirtyMins.x, 0), std::max(dirtyMins.y, 0));
+        dirtyMaxs = IntVec2(std::min(dirtyMaxs.x, m_dimensions.x - 1), std::min(dirtyMaxs.y, m_dimensions.y - 1));
 
-        for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+        int const dirtyArea = (dirtyMaxs.x - dirtyMins.x + 1) * (dirtyMaxs.y - dirtyMins.y + 1);
+
+        if (dirtyArea * 4 <= GetTileNums())
         {
-            for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+            for (int tileY = dirtyMins.y; tileY <= dirtyMaxs.y; ++tileY)
             {
-                IntVec2     tileCoords(tileX, tileY);
-                float const value = heatMap.GetValueAtCoords(tileX, tileY);
-
-                if (std::fabs(value - currentSearchValue) < FLOAT_MIN)
+                for (int tileX = dirtyMins.x; tileX <= dirtyMaxs.x; ++tileX)
                 {
-                    // Found a search value ! Spread to cardinal neighbors...
-                    IntVec2     n               = tileCoords + IntVec2(0, 1);
-                    IntVec2     e               = tileCoords + IntVec2(1, 0);
-                    IntVec2     w               = tileCoords + IntVec2(-1, 0);
-                    IntVec2     s               = tileCoords + IntVec2(0, -1);
-                    float const nextSearchValue = currentSearchValue + 1.f;
-
-                    if (!IsTileCoordsOutOfBounds(e) && !IsTileSolid(e) && !IsTileWater(e) && heatMap.GetValueAtCoords(e) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(e, nextSearchValue);
-                        isStillGoing = true;
-                    }
-
-                    if (!IsTileCoordsOutOfBounds(n) && !IsTileSolid(n) && !IsTileWater(n) && heatMap.GetValueAtCoords(n) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(n, nextSearchValue);
-                        isStillGoing = true;
-                    }
-
-                    if (!IsTileCoordsOutOfBounds(s) && !IsTileSolid(s) && !IsTileWater(s) && heatMap.GetValueAtCoords(s) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(s, nextSearchValue);
-                        isStillGoing = true;
-                    }
+                    bool const isSolid   = m_solidBits.IsSet(tileX, tileY);
+                    bool const isWater   = m_waterBits.IsSet(tileX, tileY);
+                    bool const isScorpio = m_scorpioBits.IsSet(tileX, tileY);
 
-                    if (!IsTileCoordsOutOfBounds(w) && !IsTileSolid(w) && !IsTileWater(w) && heatMap.GetValueAtCoords(w) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(w, nextSearchValue);
-                        isStillGoing = true;
-                    }
+                    m_landWanderRegionIndex.SetTileBlocked(tileX, tileY, isSolid || isScorpio);
+                    m_amphibianWanderRegionIndex.SetTileBlocked(tileX, tileY, (isSolid && !isWater) || isScorpio);
                 }
             }
+
+            return;
         }
-        currentSearchValue++;
+    }
+    else if (m_landWanderRegionIndex.IsBuilt())
+    {
+        return;
     }
 
-    // printf("( Map%d ) Finish | GenerateDistanceField\n", m_mapDef->GetIndex());
+    BuildBlockedBits(TILE_PASSABILITY_LAND_AVOID_SCORPIO, m_blockedBits);
+    m_landWanderRegionIndex.Build(m_blockedBits);
+    BuildBlockedBits(TILE_PASSABILITY_AMPHIBIAN, m_blockedBits);
+    m_amphibianWanderRegionIndex.Build(m_blockedBits);
 }
 
-void Map::PopulateDistanceFieldForEntity(TileHeatMap const& heatMap, IntVec2 const& startCoords, float specialValue) const
+//----------------------------------------------------------------------------------------------------
+// The radius reaches every tile a position within m_playerVisibilityRange of any point in the player's
+// tile can be on. A player who moves tile mid-frame just sends the rest of that frame's queries to rays.
+void Map::RefreshPlayerVisibility()
 {
-    // printf("( Map%d ) Start  | GenerateDistanceField\n", m_mapDef->GetIndex());
+    PlayerTank const* playerTank = g_game->GetPlayerTank();
 
-    heatMap.SetValueAtAllTiles(specialValue);
-    heatMap.SetValueAtCoords(startCoords, 0.f);
+    if (!playerTank) return;
 
-    float currentSearchValue = 0.f;
-    bool  isStillGoing       = true;
+    IntVec2 const  playerCoords   = GetTileCoordsFromWorldPos(playerTank->m_position);
+    uint32_t const tileGeneration = m_tileDirtyTracker.GetGeneration();
 
-    while (isStillGoing)    // For each pass, assume we're done UNLESS something changes
+    if (m_playerVisibility.IsComputed() &&
+        m_playerVisibility.GetOriginCoords() == playerCoords &&
+        m_playerVisibilityGeneration == tileGeneration)
     {
-        isStillGoing = false;
-
-        for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
-        {
-            for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
-            {
-                IntVec2     tileCoords(tileX, tileY);
-                float const value = heatMap.GetValueAtCoords(tileX, tileY);
-
-                if (std::fabs(value - currentSearchValue) < FLOAT_MIN)
-                {
-                    // Found a search value ! Spread to cardinal neighbors...
-                    IntVec2     n               = tileCoords + IntVec2(0, 1);
-                    IntVec2     e               = tileCoords + IntVec2(1, 0);
-                    IntVec2     w               = tileCoords + IntVec2(-1, 0);
-                    IntVec2     s               = tileCoords + IntVec2(0, -1);
-                    float const nextSearchValue = currentSearchValue + 1.f;
-
-                    if (!IsTileCoordsOutOfBounds(e) && !IsTileSolid(e) && !IsTileWater(e) && !IsWorldPosOccupiedByEntity(Vec2(e) + Vec2(0.5f, 0.5f), ENTITY_TYPE_SCORPIO) && heatMap.GetValueAtCoords(e) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(e, nextSearchValue);
-                        isStillGoing = true;
-                    }
-
-                    if (!IsTileCoordsOutOfBounds(n) && !IsTileSolid(n) && !IsTileWater(n) && !IsWorldPosOccupiedByEntity(Vec2(n) + Vec2(0.5f, 0.5f), ENTITY_TYPE_SCORPIO) && heatMap.GetValueAtCoords(n) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(n, nextSearchValue);
-                        isStillGoing = true;
-                    }
-
-                    if (!IsTileCoordsOutOfBounds(s) && !IsTileSolid(s) && !IsTileWater(s) && !IsWorldPosOccupiedByEntity(Vec2(s) + Vec2(0.5f, 0.5f), ENTITY_TYPE_SCORPIO) && heatMap.GetValueAtCoords(s) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(s, nextSearchValue);
-                        isStillGoing = true;
-                    }
-
-                    if (!IsTileCoordsOutOfBounds(w) && !IsTileSolid(w) && !IsTileWater(w) && !IsWorldPosOccupiedByEntity(Vec2(w) + Vec2(0.5f, 0.5f), ENTITY_TYPE_SCORPIO) && heatMap.GetValueAtCoords(w) > nextSearchValue)
-                    {
-                        heatMap.SetValueAtCoords(w, nextSearchValue);
-                        isStillGoing = true;
-                    }
-                }
-            }
-        }
-        currentSearchValue++;
+        return;
     }
 
-    // printf("( Map%d ) Finish | GenerateDistanceField\n", m_mapDef->GetIndex());
+    m_playerVisibility.Compute(GetRayBlockedBits(), playerCoords, RoundDownToInt(m_playerVisibilityRange) + 1);
+    m_playerVisibilityGeneration = tileGeneration;
 }
 
-
 //----------------------------------------------------------------------------------------------------
-void Map::PopulateDistanceFieldForLandBased(TileHeatMap const& heatMap) const
+// Runs with the tiles, so a snapshot that already carried a matching table skips the build
+void Map::BuildVisibilityTableIfNeeded()
 {
-    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
-    {
-        for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
-        {
-            Vec2 worldPos = Vec2(tileX, tileY) + Vec2(0.5f, 0.5f);
+    if (m_visibilityTableRadius <= 0) return;
 
-            if (IsWorldPosOccupiedByEntity(worldPos, ENTITY_TYPE_SCORPIO))
-            {
-                continue;
-            }
+    if (!TileVisibilityTable::IsWithinBudget(m_dimensions, m_visibilityTableRadius))
+    {
+        printf("( Map%d ) WARNING: map too large for a visibility table of radius %d, skipping it\n", m_mapDef->GetIndex(), m_visibilityTableRadius);
+        return;
+    }
 
-            IntVec2 tileCoords(tileX, tileY);
+    TileBitboard const& rayBlockedBits = GetRayBlockedBits();
 
-            if (!IsTileCoordsOutOfBounds(tileCoords) && !IsTileSolid(tileCoords))
-            {
-                heatMap.SetValueAtCoords(tileCoords, 0.f);
-            }
-        }
+    if (m_visibilityTable.GetRadius() != m_visibilityTableRadius || !m_visibilityTable.IsBuiltOver(rayBlockedBits))
+    {
+        printf("( Map%d ) Start  | BuildVisibilityTable\n", m_mapDef->GetIndex());
+        m_visibilityTable.Build(rayBlockedBits, m_visibilityTableRadius);
+        printf("( Map%d ) Finish | BuildVisibilityTable\n", m_mapDef->GetIndex());
     }
+
+    m_visibilityTableGeneration = m_tileDirtyTracker.GetGeneration();
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::PopulateDistanceFieldForAmphibian(TileHeatMap const& heatMap) const
+// Tile changes that leave the ray-blocking terrain alone (scorpios moving, floor swaps) keep the table;
+// anything else drops it, and the callers go back to rays.
+bool Map::IsVisibilityTableCurrent() const
 {
-    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
-    {
-        for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
-        {
-            Vec2 worldPos = Vec2(tileX, tileY) + Vec2(0.5f, 0.5f);
+    if (!m_visibilityTable.IsBuilt()) return false;
 
-            if (IsWorldPosOccupiedByEntity(worldPos, ENTITY_TYPE_SCORPIO))
-            {
-                continue;
-            }
+    uint32_t const tileGeneration = m_tileDirtyTracker.GetGeneration();
 
-            IntVec2 tileCoords(tileX, tileY);
+    if (m_visibilityTableGeneration == tileGeneration) return true;
 
-            if (!IsTileCoordsOutOfBounds(tileCoords) &&
-                !IsTileSolid(tileCoords) ||
-                IsTileWater(tileCoords))
-            {
-                heatMap.SetValueAtCoords(tileCoords, 0.f);
-            }
-        }
+    if (!m_visibilityTable.IsBuiltOver(GetRayBlockedBits()))
+    {
+        m_visibilityTable.Clear();
+        return false;
     }
+
+    m_visibilityTableGeneration = tileGeneration;
+    return true;
 }
 
-void Map::PopulateDistanceFieldToPosition(TileHeatMap const& heatMap, IntVec2 const& playerCoords) const
+//----------------------------------------------------------------------------------------------------
+// Landmarks only stop being admissible when a tile opens up under TILE_PASSABILITY_ANY_TERRAIN, so a
+// dirty rect that only closed tiles (or moved Scorpios) keeps them
+void Map::BuildPathLandmarksIfStale() const
 {
-    // printf("( Map%d ) Start  | GenerateDistanceFieldToPlayerPosition\n", m_mapDef->GetIndex());
+    uint32_t const tileGeneration = m_tileDirtyTracker.GetGeneration();
+    bool const     isBuilt        = m_pathLandmarkBlockedBits.GetDimensions() == m_dimensions;
 
-    heatMap.SetValueAtAllTiles(999.f);
-    heatMap.SetValueAtCoords(playerCoords, 0.f);
+    if (isBuilt && m_pathLandmarksGeneration == tileGeneration) return;
 
-    std::queue<IntVec2> openList;
-    openList.push(playerCoords);
+    BuildBlockedBits(TILE_PASSABILITY_ANY_TERRAIN, m_blockedBits);
 
-    while (!openList.empty())
-    {
-        IntVec2 currentTile = openList.front();
-        openList.pop();
+    IntVec2 dirtyMins      = IntVec2::ONE;    // Empty rect unless the tracker reports one
+    IntVec2 dirtyMaxs      = IntVec2::ZERO;
+    bool    hasOpenedTiles = !isBuilt;
 
-        float const currentDistance = heatMap.GetValueAtCoords(currentTile);
+    if (isBuilt && m_tileDirtyTracker.GetDirtyRectSince(m_pathLandmarksGeneration, dirtyMins, dirtyMaxs))
+    {
+        dirtyMins = IntVec2(std::max(dirtyMins.x, 0), std::max(dirtyMins.y, 0));
+        dirtyMaxs = IntVec2(std::min(dirtyMaxs.x, m_dimensions.x - 1), std::min(dirtyMaxs.y, m_dimensions.y - 1));
+    }
 
-        // ???? tile ??????? (N, E, S, W)
-        IntVec2 neighbors[] = {
-            currentTile + IntVec2(0, 1),  // ? (N)
-            currentTile + IntVec2(1, 0),  // ? (E)
-            currentTile + IntVec2(0, -1), // ? (S)
-            currentTile + IntVec2(-1, 0)  // ? (W)
-        };
+    for (int tileY = dirtyMins.y; !hasOpenedTiles && tileY <= dirtyMaxs.y; ++tileY)
+    {
+        uint64_t const* landmarkRow = m_pathLandmarkBlockedBits.GetRow(tileY);
+        uint64_t const* currentRow  = m_blockedBits.GetRow(tileY);
 
-        for (IntVec2 const& neighbor : neighbors)
+        for (int wordIndex = 0; wordIndex < m_blockedBits.GetWordsPerRow(); ++wordIndex)
         {
-            if (IsTileCoordsOutOfBounds(neighbor) || IsTileSolid(neighbor) || IsWorldPosOccupiedByEntity(Vec2(neighbor) + Vec2(0.5f, 0.5f), ENTITY_TYPE_SCORPIO))
-            {
-                continue; // ??????????????
-            }
-
-            float const neighborDistance = heatMap.GetValueAtCoords(neighbor);
-            float const newDistance      = currentDistance + 1.f; // ??? tile ??? +1
-
-            if (newDistance < neighborDistance) // ?????????
-            {
-                heatMap.SetValueAtCoords(neighbor, newDistance);
-                openList.push(neighbor); // ??????????????
-            }
+            if ((landmarkRow[wordIndex] & ~currentRow[wordIndex]) != 0) hasOpenedTiles = true;
         }
     }
 
-    // printf("( Map%d ) Finish | GenerateDistanceFieldToPlayerPosition\n", m_mapDef->GetIndex());
-}
+    m_pathLandmarksGeneration = tileGeneration;
 
-std::vector<Vec2> Map::GenerateEntityPathToGoal(TileHeatMap const& heatMap, Vec2 const& start, Vec2 const& goal) const
-{
-    // 初始化熱圖，設置高初始值
-    // TileHeatMap heatMap(GetMapDimension(), 999.f);
+    if (!hasOpenedTiles) return;
 
-    // 計算目標在地圖上的座標
-    IntVec2 goalCoords = GetTileCoordsFromWorldPos(goal);
+    m_pathLandmarkBlockedBits = m_blockedBits;
+    m_tilePathfinder.BuildLandmarks(m_pathLandmarkBlockedBits, m_startPosition, NUM_PATH_LANDMARKS);
+}
 
-    // 填充距離場，用於計算路徑
-    PopulateDistanceFieldToPosition(heatMap, goalCoords);
+//----------------------------------------------------------------------------------------------------
+// Any tile change bumps the dirty tracker's generation, which is what marks a cached field stale
+DistanceField const& Map::GetFlowFieldToGoal(IntVec2 const& goalCoords, TilePassability const passability)
+{
+    uint32_t const       tileGeneration  = m_tileDirtyTracker.GetGeneration();
+    FlowFieldCacheEntry* nearest         = nullptr;
+    FlowFieldCacheEntry* leastRecent     = &m_flowFieldCache[0];
+    int                  nearestDistance = FLOW_FIELD_MAX_REPAIR_DISTANCE + 1;
 
-    // 設置當前位置
-    IntVec2           currentCoords = GetTileCoordsFromWorldPos(start);
-    std::vector<Vec2> path;
-    path.reserve((int)(m_dimensions.x * m_dimensions.y));
+    ++m_flowFieldCacheTick;
 
-    while (currentCoords != goalCoords)
+    for (FlowFieldCacheEntry& entry : m_flowFieldCache)
     {
-        path.push_back(GetWorldPosFromTileCoords(currentCoords));
-
-        // 找到熱值最低的相鄰 tile
-        IntVec2 bestNeighbor = currentCoords;
-        float   lowestHeat   = heatMap.GetValueAtCoords(currentCoords);
-
-        for (IntVec2 const& offset : {IntVec2(-1, 0), IntVec2(1, 0), IntVec2(0, -1), IntVec2(0, 1)})
+        if (entry.m_field && entry.m_passability == passability)
         {
-            IntVec2 neighbor = currentCoords + offset;
-            float   heat     = heatMap.GetValueAtCoords(neighbor);
+            IntVec2 const offset   = entry.m_goalCoords - goalCoords;
+            int const     distance = std::abs(offset.x) + std::abs(offset.y);
 
-            if (heat < lowestHeat)
+            if (distance < nearestDistance)
             {
-                lowestHeat   = heat;
-                bestNeighbor = neighbor;
+                nearest         = &entry;
+                nearestDistance = distance;
             }
         }
 
-        // 更新當前位置
-        currentCoords = bestNeighbor;
+        if (!entry.m_field || (leastRecent->m_field && entry.m_lastUsedTick < leastRecent->m_lastUsedTick))
+        {
+            leastRecent = &entry;
+        }
     }
 
-    // 添加最終目標點
-    path.push_back(goal);
-    std::reverse(path.begin(), path.end());
-    return path;
+    if (nearest)
+    {
+        if (nearestDistance != 0 || nearest->m_tileGeneration != tileGeneration)
+        {
+            RepairDistanceField(*nearest->m_field, nearest->m_goalCoords, goalCoords, nearest->m_tileGeneration, passability);
+        }
+    }
+    else
+    {
+        nearest = leastRecent;
+
+        if (!nearest->m_field)
+        {
+            nearest->m_field = m_distanceFieldPool.Acquire();
+        }
+
+        PopulateDistanceField(*nearest->m_field, goalCoords, passability);
+    }
+
+    nearest->m_goalCoords     = goalCoords;
+    nearest->m_passability    = passability;
+    nearest->m_tileGeneration = tileGeneration;
+    nearest->m_lastUsedTick   = m_flowFieldCacheTick;
+
+    return *nearest->m_field;
 }
 
+//----------------------------------------------------------------------------------------------------
 bool Map::RaycastHitsImpassable(Vec2 const& currentPos, Vec2 const& nextNextPos)
 {
     Vec2            direction       = nextNextPos - currentPos;
@@ -1078,6 +1783,17 @@ void Map::AddEntityToMap(Entity* entity, Vec2 const& position, float const orien
     AddEntityToList(entity, m_allEntities);
     AddEntityToList(entity, m_entitiesByType[entity->m_type]);
 
+    if (entity->m_type == ENTITY_TYPE_SCORPIO)
+    {
+        IntVec2 const tileCoords = GetTileCoordsFromWorldPos(position);
+
+        if (!IsTileCoordsOutOfBounds(tileCoords))
+        {
+            m_scorpioBits.Set(tileCoords.x, tileCoords.y);
+            m_tileDirtyTracker.MarkDirty(tileCoords.x, tileCoords.y);    // Scorpio tiles change passability
+        }
+    }
+
     if (IsBullet(entity)) AddEntityToList(entity, m_bulletsByFaction[entity->m_faction]);
 
     if (IsAgent(entity)) AddEntityToList(entity, m_agentsByFaction[entity->m_faction]);
@@ -1095,10 +1811,25 @@ void Map::RemoveEntityFromMap(Entity* entity)
     RemoveEntityFromList(entity, m_allEntities);
     RemoveEntityFromList(entity, m_entitiesByType[entity->m_type]);
 
+    if (entity->m_type == ENTITY_TYPE_SCORPIO)
+    {
+        IntVec2 const tileCoords = GetTileCoordsFromWorldPos(entity->m_position);
+
+        if (!IsTileCoordsOutOfBounds(tileCoords))
+        {
+            m_scorpioBits.Clear(tileCoords.x, tileCoords.y);
+            m_tileDirtyTracker.MarkDirty(tileCoords.x, tileCoords.y);
+        }
+    }
+
     if (IsAgent(entity)) RemoveEntityFromList(entity, m_agentsByFaction[entity->m_faction]);
 
     if (IsBullet(entity)) RemoveEntityFromList(entity, m_bulletsByFaction[entity->m_faction]);
 
+    if (entity == m_currentSelectedEntity) m_currentSelectedEntity = nullptr;
+
+    m_pathRequestQueue.Cancel(entity->m_pathRequestHandle);
+    entity->m_pathRequestHandle = INVALID_PATH_REQUEST_HANDLE;
     entity->m_map = nullptr;
 }
 
@@ -1145,20 +1876,20 @@ void Map::SpawnNewNPCs()
 
         if (IsWorldPosOccupied(worldPosition)) continue;
 
-        switch (g_rng->RollRandomIntInRange(0, 3))
+        switch (m_generationRng.RollRandomIntInRange(0, 3))
         {
         case 0:
-            if (g_rng->RollRandomFloatZeroToOne() < m_mapDef->GetScorpioSpawnPercentage()) SpawnNewEntity(ENTITY_TYPE_SCORPIO, ENTITY_FACTION_EVIL, worldPosition, 0.f);
+            if (m_generationRng.RollRandomFloatZeroToOne() < m_mapDef->GetScorpioSpawnPercentage()) SpawnNewEntity(ENTITY_TYPE_SCORPIO, ENTITY_FACTION_EVIL, worldPosition, 0.f);
 
             break;
 
         case 1:
-            if (g_rng->RollRandomFloatZeroToOne() < m_mapDef->GetLeoSpawnPercentage()) SpawnNewEntity(ENTITY_TYPE_LEO, ENTITY_FACTION_EVIL, worldPosition, 0.f);
+            if (m_generationRng.RollRandomFloatZeroToOne() < m_mapDef->GetLeoSpawnPercentage()) SpawnNewEntity(ENTITY_TYPE_LEO, ENTITY_FACTION_EVIL, worldPosition, 0.f);
 
             break;
 
         case 2:
-            if (g_rng->RollRandomFloatZeroToOne() < m_mapDef->GetAriesSpawnPercentage()) SpawnNewEntity(ENTITY_TYPE_ARIES, ENTITY_FACTION_EVIL, worldPosition, 0.f);
+            if (m_generationRng.RollRandomFloatZeroToOne() < m_mapDef->GetAriesSpawnPercentage()) SpawnNewEntity(ENTITY_TYPE_ARIES, ENTITY_FACTION_EVIL, worldPosition, 0.f);
 
             break;
         }
@@ -1200,6 +1931,9 @@ void Map::PushEntityOutOfSolidTiles(Entity* entity) const
 {
     IntVec2 const myTileCoords = GetTileCoordsFromWorldPos(entity->m_position);
 
+    // Nothing solid in the 3x3 neighborhood (out-of-bounds tiles never push), so skip the per-tile tests
+    if (!m_solidBits.IsAnySetInRect(myTileCoords - IntVec2::ONE, myTileCoords + IntVec2::ONE)) return;
+
     // Push out of cardinal neighbors (NSEW) first
     PushEntityOutOfTileIfSolid(entity, myTileCoords + IntVec2(1, 0));
     PushEntityOutOfTileIfSolid(entity, myTileCoords + IntVec2(0, 1));
@@ -1316,51 +2050,101 @@ void Map::CheckEntityVsEntityCollision(EntityList const& entityListA, EntityList
 }
 
 //----------------------------------------------------------------------------------------------------
+// Exact grid traversal: cost follows the tiles crossed, not the ray length. See TileRaycaster.
 RaycastResult2D Map::RaycastVsTiles(Ray2 const& ray) const
+{
+    return TileRaycaster::Raycast(GetRayBlockedBits(), ray);
+}
+
+//----------------------------------------------------------------------------------------------------
+// One result per ray, in order; rays are traced four at a time, so prefer this over a loop of single casts
+void Map::RaycastVsTiles(std::vector<Ray2> const& rays, std::vector<RaycastResult2D>& out_results) const
+{
+    out_results.resize(rays.size());
+
+    if (rays.empty()) return;
+
+    TileRaycaster::RaycastBatch(GetRayBlockedBits(), rays.data(), static_cast<int>(rays.size()), out_results.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs once entities have moved, so the lasers Render draws match this frame's positions. The rays run to
+// the far wall, which is where batching them pays off most.
+void Map::TraceScorpioLasers()
+{
+    m_laserRays.clear();
+
+    for (Entity const* entity : m_entitiesByType[ENTITY_TYPE_SCORPIO])
+    {
+        if (!entity || entity->m_isDead) continue;
+
+        m_laserRays.push_back(static_cast<Scorpio const*>(entity)->GetLaserRay());
+    }
+
+    RaycastVsTiles(m_laserRays, m_laserResults);
+
+    int laserIndex = 0;
+
+    for (Entity* entity : m_entitiesByType[ENTITY_TYPE_SCORPIO])
+    {
+        if (!entity || entity->m_isDead) continue;
+
+        static_cast<Scorpio*>(entity)->SetLaserImpactPosition(m_laserResults[laserIndex].m_impactPosition);
+        ++laserIndex;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Continuous collision for a disc moving along the ray: the impact is where its center is at first contact
+// with a tile that stops rays, so any speed or timestep is safe. See TileRaycaster::SweepDisc.
+RaycastResult2D Map::SweepDiscVsTiles(Ray2 const& ray, float const discRadius) const
+{
+    return TileRaycaster::SweepDisc(GetRayBlockedBits(), ray, discRadius);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same, against the entities CheckEntityVsEntityCollision would hit with a bullet of another faction than
+// ignoredFaction. Entities the disc already overlaps are skipped; that overlap pass owns them.
+RaycastResult2D Map::SweepDiscVsEntities(Ray2 const& ray, float const discRadius, EntityFaction const ignoredFaction) const
 {
     RaycastResult2D raycastResult;
     raycastResult.m_rayForwardNormal = ray.m_forwardNormal;
     raycastResult.m_rayStartPosition = ray.m_startPosition;
     raycastResult.m_rayMaxLength     = ray.m_maxLength;
-    raycastResult.m_didImpact        = false;
-
-    constexpr float stepSize   = 0.01f;
-    Vec2            currentPos = ray.m_startPosition;
 
+    for (Entity const* entity : m_allEntities)
+    {
+        if (!entity || entity->m_isDead || IsBullet(entity)) continue;
 
-    // Calculate the number of steps needed
-    const int numSteps = static_cast<int>(ray.m_maxLength / stepSize);
+        if (entity->m_faction == ignoredFaction) continue;
 
-    for (int i = 0; i < numSteps; ++i)
-    {
-        const float t            = static_cast<float>(i) * stepSize;
-        currentPos               = ray.m_startPosition + ray.m_forwardNormal * t;
-        Vec2          prePos     = currentPos - ray.m_forwardNormal * stepSize;
-        IntVec2 const tileCoords = GetTileCoordsFromWorldPos(currentPos);
+        float const contactRadius = discRadius + entity->m_physicsRadius;
 
-        // Check bounds
-        if (IsTileCoordsOutOfBounds(tileCoords))
-        {
-            raycastResult.m_didImpact  = true;
-            raycastResult.m_impactLength = t;
-            raycastResult.m_impactPosition  = currentPos;
+        if (IsPointInsideDisc2D(ray.m_startPosition, entity->m_position, contactRadius)) continue;
 
-            return raycastResult; // Out of bounds is considered blocking
-        }
+        RaycastResult2D const entityResult = RaycastVsDisc2D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength, entity->m_position, contactRadius);
 
-        // Check tile blocking
+        if (!entityResult.m_didImpact) continue;
 
-        if (IsTileSolid(tileCoords) && !IsTileWater(tileCoords))
-        {
-            raycastResult.m_didImpact     = true;
-            raycastResult.m_impactLength    = t;
-            raycastResult.m_impactPosition     = currentPos;
-            IntVec2 const impactFwdNormal = GetTileCoordsFromWorldPos(currentPos) - GetTileCoordsFromWorldPos(prePos);
-            raycastResult.m_impactNormal  = Vec2(impactFwdNormal);
+        if (raycastResult.m_didImpact && entityResult.m_impactLength >= raycastResult.m_impactLength) continue;
 
-            return raycastResult;
-        }
+        raycastResult = entityResult;
     }
 
     return raycastResult;
 }
+
+//----------------------------------------------------------------------------------------------------
+// DoesTileBlockRays as a bitboard, rebuilt at most once per tile generation
+TileBitboard const& Map::GetRayBlockedBits() const
+{
+    uint32_t const tileGeneration = m_tileDirtyTracker.GetGeneration();
+
+    if (m_rayBlockedBits.GetDimensions() != m_dimensions || m_rayBlockedBitsGeneration != tileGeneration)
+    {
+        BuildBlockedBits(TILE_PASSABILITY_ANY_TERRAIN, m_rayBlockedBits);
+        m_rayBlockedBitsGeneration = tileGeneration;
+    }
+
+    return m_rayBlockedBits;
+}
@@ -9,20 +9,52 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/DistanceField.hpp"
+#include "Game/DistanceFieldPool.hpp"
 #include "Game/Entity.hpp"
 #include "Game/MapDefinition.hpp"
+#include "Game/MapSnapshot.hpp"
+#include "Game/PathRequestQueue.hpp"
+#include "Game/SeededRandomStream.hpp"
+#include "Game/TileBitboard.hpp"
+#include "Game/TileChunkGrid.hpp"
+#include "Game/TileClusterGraph.hpp"
+#include "Game/TileConnectivity.hpp"
+#include "Game/TileDefinition.hpp"
+#include "Game/TileDirtyTracker.hpp"
+#include "Game/TileFloodFill.hpp"
+#include "Game/TilePathfinder.hpp"
+#include "Game/TileRegionIndex.hpp"
+#include "Game/TileVisibilityTable.hpp"
+#include "Game/TileVisibilityField.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class TileHeatMap;
-struct Tile;
+
+//----------------------------------------------------------------------------------------------------
+// Which tiles a distance field may walk through; see BuildBlockedBits for the exact rules
+enum TilePassability : int
+{
+    TILE_PASSABILITY_LAND,                  // Not solid, not water
+    TILE_PASSABILITY_LAND_AVOID_SCORPIO,    // Land, and no Scorpio on the tile
+    TILE_PASSABILITY_AMPHIBIAN,             // Water is open, other solid tiles are not; no Scorpio on the tile
+    TILE_PASSABILITY_ANY_TERRAIN,           // Amphibian, ignoring Scorpios: the most any mover can cross
+    NUM_TILE_PASSABILITIES
+};
 
 //-----------------------------------------------------------------------------------------------
 class Map
 {
 public:
-    explicit Map(MapDefinition const& mapDef);
+    Map(MapDefinition const& mapDef, unsigned int generationSeed);
     ~Map();
 
+    // Construction is split so Game can build several maps at once: GenerateTiles only touches this
+    // Map (safe on a worker thread), SpawnInitialEntities creates entities and must run on the main thread
+    void GenerateTiles();
+    void SpawnInitialEntities();
+
     void Update(float deltaSeconds);
     void Render() const;
     void DebugRender() const;
@@ -36,60 +68,110 @@ public:
     AABB2 const   GetMapBound() const { return AABB2(IntVec2::ZERO, m_dimensions); }
     int           GetMapIndex() const { return m_mapDef->GetIndex(); }
     int           GetTileNums() const { return m_dimensions.x * m_dimensions.y; }
+    TileTypeIndex GetTileTypeIndexAtCoords(IntVec2 const& tileCoords) const { return m_tiles.GetTileTypeIndex(tileCoords.x, tileCoords.y); }
+
+    // Every tile change is recorded here; derived data compares generations to find what to rebuild
+    TileDirtyTracker const& GetTileDirtyTracker() const { return m_tileDirtyTracker; }
 
     // Mutators (non-const methods)
     Entity* SpawnNewEntity(EntityType type, EntityFaction faction, Vec2 const& position, float orientationDegrees);
     void    AddEntityToMap(Entity* entity, Vec2 const& position, float orientationDegrees);
     void    RemoveEntityFromMap(Entity* entity);
+    bool    SaveSnapshot();
+    bool    ChangeTileAtCoords(IntVec2 const& tileCoords, TileTypeIndex tileTypeIndex);
 
     // Helpers
     RaycastResult2D RaycastVsTiles(Ray2 const& ray) const;
+    void            RaycastVsTiles(std::vector<Ray2> const& rays, std::vector<RaycastResult2D>& out_results) const;
+    RaycastResult2D SweepDiscVsTiles(Ray2 const& ray, float discRadius) const;
+    RaycastResult2D SweepDiscVsEntities(Ray2 const& ray, float discRadius, EntityFaction ignoredFaction) const;
     bool            HasLineOfSight(Vec2 const& startPos, Vec2 const& endPos, float sightRange) const;
+    TileVisibility  GetTileVisibility(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
     bool            IsTileSolid(IntVec2 const& tileCoords) const;
     bool            IsTileWater(IntVec2 const& tileCoords) const;
+    bool            IsTileOccupiedByScorpio(IntVec2 const& tileCoords) const;
+    bool            DoesTileBlockRays(IntVec2 const& tileCoords) const;
     bool            IsPointInSolid(Vec2 const& point) const;
     bool            IsTileCoordsOutOfBounds(IntVec2 const& tileCoords) const;
-    IntVec2         RollRandomTileCoords() const;
-    IntVec2         RollRandomTraversableTileCoords(TileHeatMap const& heatMap, IntVec2 const& startCoords) const;
-
-    // Heatmap-related
-    void              GenerateHeatMaps(TileHeatMap const& heatMap) const;
-    void              PopulateDistanceField(TileHeatMap const& heatMap, IntVec2 const& startCoords, float specialValue) const;
-    void              PopulateDistanceFieldForEntity(TileHeatMap const& heatMap, IntVec2 const& startCoords, float specialValue) const;
-    void              PopulateDistanceFieldForLandBased(TileHeatMap const& heatMap) const;
-    void              PopulateDistanceFieldForAmphibian(TileHeatMap const& heatMap) const;
-    void              PopulateDistanceFieldToPosition(TileHeatMap const& heatMap, IntVec2 const& playerCoords) const;
-    std::vector<Vec2> GenerateEntityPathToGoal(TileHeatMap const& heatMap,Vec2 const& start, Vec2 const& goal) const;
+    IntVec2         RollRandomTileCoords();
+    IntVec2         RollRandomTraversableTileCoords(IntVec2 const& startCoords, TilePassability passability) const;
+
+    // Distance-field-related; unreachable tiles hold DistanceField::UNREACHABLE
+    void              PopulateDistanceField(DistanceField& field, IntVec2 const& startCoords, TilePassability passability) const;
+    void              PopulateDistanceField(DistanceField& field, IntVec2 const& startCoords) const;
+    void              RepairDistanceField(DistanceField& field, IntVec2 const& oldStartCoords, IntVec2 const& newStartCoords, uint32_t fieldGeneration, TilePassability passability) const;
+    void              PopulateDistanceFieldForEntity(DistanceField& field, IntVec2 const& startCoords) const;
+    void              PopulateDistanceFieldForLandBased(DistanceField& field) const;
+    void              PopulateDistanceFieldForAmphibian(DistanceField& field) const;
+    void              PopulateDistanceFieldToPosition(DistanceField& field, IntVec2 const& playerCoords) const;
+    std::vector<Vec2> GenerateEntityPathToGoal(DistanceField& field, Vec2 const& start, Vec2 const& goal) const;
+    std::vector<Vec2> GenerateEntityPathAlongField(DistanceField const& field, Vec2 const& start, Vec2 const& goal) const;
+    std::vector<Vec2> FindEntityPathToGoal(Vec2 const& start, Vec2 const& goal, TilePassability passability, PathHeuristic heuristic) const;
+    std::vector<Vec2> FindEntityJumpPointPathToGoal(Vec2 const& start, Vec2 const& goal, TilePassability passability) const;
+
+    // Shared by every entity heading for the same tile: built at most once per (goal, passability, tile generation).
+    // A goal that moved a tile or two, or tiles that changed since, are repaired in place instead of rebuilt.
+    DistanceField const& GetFlowFieldToGoal(IntVec2 const& goalCoords, TilePassability passability);
+
+    // Entity paths are solved at the end of Map::Update within the configured frame budget; poll the
+    // handle on later frames. Passing back a still-pending handle re-aims that request instead.
+    PathRequestHandle RequestEntityPath(PathRequestHandle pendingHandle, PathRequest const& request);
+    bool              TakeEntityPathResult(PathRequestHandle handle, std::vector<Vec2>& out_path);
     bool              RaycastHitsImpassable(Vec2 const& currentPos, Vec2 const& nextNextPos);
 
 private:
     void UpdateEntities(float deltaSeconds) const;
     void RenderTiles() const;
+    void RebuildDirtyTileVerts() const;
+    void RebuildTileVertsForChunk(int chunkX, int chunkY) const;
     void RenderEntities() const;
     void RenderTileHeatMap() const;
+    DistanceField const* GetDebugDistanceField() const;
     void DebugRenderEntities() const;
     void DebugRenderTileIndex() const;
 
-    void InitializeTileHeatMaps();
+    void BuildBlockedBits(TilePassability passability, TileBitboard& out_blockedBits) const;
+    void PopulatePassabilityMap(DistanceField& field, TilePassability passability) const;
+
+    std::vector<Vec2>   MakeEntityPathFromTiles(std::vector<IntVec2> const& tilePath, IntVec2 const& startCoords, Vec2 const& goal) const;
+    void                BuildPathLandmarksIfStale() const;
+    TileClusterGraph&   RefreshClusterGraph(TilePassability passability, TileBitboard const& blockedBits) const;
+    void                SyncWanderRegionIndices() const;
+    TileBitboard const& GetRayBlockedBits() const;
+    void                RefreshPlayerVisibility();
+    void                TraceScorpioLasers();
+    void                BuildVisibilityTableIfNeeded();
+    bool                IsVisibilityTableCurrent() const;
+
+    void CreateTileHeatMapsIfNeeded();
+    void RefreshDirtyTileHeatMaps();
+
+    void              ServicePathRequests();
+    std::vector<Vec2> SolvePathRequest(PathRequest const& request);
+
+    // Snapshot-related
+    String GetSnapshotCaptureFilePath() const;
+    bool   LoadSnapshot(String const& filePath);
 
 // Map-related
     void GenerateAllTiles();
-    void GenerateTilesByType(String const& tileName);
-    void GenerateWormTiles(String const& wormTileName, int numWorms, int wormLength);
+    void GenerateTileLayout();
+    void GenerateTilesByType(TileTypeIndex tileTypeIndex);
+    void FillAllTiles(TileTypeIndex tileTypeIndex);
+    void GenerateWormTiles(TileTypeIndex wormTileTypeIndex, int numWorms, int wormLength);
     void GenerateLShapeTiles(int tileCoordX, int tileCoordY, int width, int height, bool isBottomLeft);
     void GenerateStartPosTile();
     void GenerateExitPosTile();
-    void SetTileAtCoords(String const& tileName, int tileX, int tileY);
-    void ConvertUnreachableTilesToSolid(TileHeatMap const& heatMap, String const& tileName);
+    void SetTileAtCoords(TileTypeIndex tileTypeIndex, int tileX, int tileY);
+    void ConvertUnreachableTilesToSolid(TileTypeIndex solidTileTypeIndex);
     bool IsEdgeTile(int x, int y) const;
     bool IsTileCoordsInLShape(int x, int y) const;
     bool IsWorldPosOccupied(Vec2 const& position) const;
-    bool IsWorldPosOccupiedByEntity(Vec2 const& position, EntityType type) const;
-    bool IsValidMap(IntVec2 const& startCoords, IntVec2 const& exitCoords, int maxAttempts);
+    bool IsValidMap();
 
     AABB2 const GetTileBounds(IntVec2 const& tileCoords) const;
     AABB2 const GetTileBounds(int tileIndex) const;
-    IntVec2     RollRandomCardinalDirection() const;
+    IntVec2     RollRandomCardinalDirection();
 
     // Entity-lifetime-related
     Entity* CreateNewEntity(EntityType type, EntityFaction faction);
@@ -107,7 +189,12 @@ private:
     void PushEntitiesOutOfEachOther(EntityList const& entityListA, EntityList const& entityListB) const;
     void CheckEntityVsEntityCollision(EntityList const& entityListA, EntityList const& entityListB);
 
-    std::vector<Tile>    m_tiles;
+    TileChunkGrid        m_tiles;               // Uniform chunks cost no tile storage, see TileChunkGrid
+    TileDirtyTracker     m_tileDirtyTracker;    // Marked by SetTileAtCoords / FillAllTiles and Scorpio add / remove
+    TileBitboard         m_solidBits;           // Kept in sync by SetTileAtCoords
+    TileBitboard         m_waterBits;           // Kept in sync by SetTileAtCoords
+    TileBitboard         m_scorpioBits;         // Kept in sync by AddEntityToMap / RemoveEntityFromMap
+    TileConnectivity     m_tileConnectivity;    // Built per layout by IsValidMap during generation
     EntityList           m_allEntities;
     EntityList           m_entitiesByType[NUM_ENTITY_TYPES];
     EntityList           m_agentsByFaction[NUM_ENTITY_FACTIONS];
@@ -116,9 +203,99 @@ private:
     IntVec2              m_exitPosition  = IntVec2::ZERO;
     IntVec2              m_dimensions;
     MapDefinition const* m_mapDef = nullptr;
+    SeededRandomStream   m_generationRng;    // Tile generation and initial NPC spawns only; gameplay uses g_rng
+
+    // Set by LoadSnapshot, consumed by SpawnInitialEntities on the main thread
+    bool                          m_isLoadedFromSnapshot = false;
+    std::vector<MapSnapshotSpawn> m_snapshotSpawns;
+
+    // Well-known tile types used by generation, resolved once from their names
+    TileTypeIndex m_stoneTileTypeIndex = 0;
+    TileTypeIndex m_floorTileTypeIndex = 0;
+    TileTypeIndex m_startTileTypeIndex = 0;
+    TileTypeIndex m_exitTileTypeIndex  = 0;
+
+    // Render cache, one vertex list per TileChunkGrid chunk, rebuilt only where tiles changed
+    mutable std::vector<VertexList_PCU> m_tileVertsByChunk;
+    mutable uint32_t                    m_tileVertsGeneration = 0;
+
+    // Owns every DistanceField this map hands out: debug maps, flow fields and entity scratch
+    DistanceFieldPool m_distanceFieldPool;
+
+    // Flow-field cache; on a miss the entry with the nearest goal is repaired, else the least recently used is rebuilt
+    struct FlowFieldCacheEntry
+    {
+        DistanceField*  m_field          = nullptr;
+        IntVec2         m_goalCoords     = IntVec2::ZERO;
+        TilePassability m_passability    = TILE_PASSABILITY_LAND;
+        uint32_t        m_tileGeneration = 0;
+        uint32_t        m_lastUsedTick   = 0;
+    };
+
+    static constexpr int FLOW_FIELD_CACHE_SIZE        = 4;
+    static constexpr int FLOW_FIELD_MAX_REPAIR_DISTANCE = 2;    // In tiles (Manhattan) between the cached and the new goal
+
+    FlowFieldCacheEntry m_flowFieldCache[FLOW_FIELD_CACHE_SIZE];
+    uint32_t            m_flowFieldCacheTick = 0;
+
+    // Point-to-point A*; landmarks are built over TILE_PASSABILITY_ANY_TERRAIN so they hold for every passability
+    static constexpr int NUM_PATH_LANDMARKS = 4;
+
+    mutable TilePathfinder       m_tilePathfinder;
+    mutable TileBitboard         m_pathLandmarkBlockedBits;    // What the landmarks were built over
+    mutable uint32_t             m_pathLandmarksGeneration = 0;
+    mutable std::vector<IntVec2> m_tilePath;
+
+    // HPA* graphs, one per passability, built with the tiles and patched from the dirty tracker after that.
+    // Paths shorter than HIERARCHICAL_PATH_MIN_DISTANCE (Manhattan, in tiles) go straight to m_tilePathfinder.
+    static constexpr int HIERARCHICAL_PATH_MIN_DISTANCE = 2 * TileClusterGraph::CLUSTER_SIZE;
+
+    mutable TileClusterGraph m_clusterGraphs[NUM_TILE_PASSABILITIES];
+    mutable uint32_t         m_clusterGraphGenerations[NUM_TILE_PASSABILITIES] = {};
+
+    // Open tiles per region for each wander passability, so a wander goal is one random index
+    mutable TileRegionIndex m_landWanderRegionIndex;      // TILE_PASSABILITY_LAND_AVOID_SCORPIO
+    mutable TileRegionIndex m_amphibianWanderRegionIndex; // TILE_PASSABILITY_AMPHIBIAN
+    mutable uint32_t        m_wanderRegionGeneration = 0;
+
+    // Entity path requests, solved for up to m_pathRequestBudgetSeconds per frame (at least one per frame)
+    PathRequestQueue m_pathRequestQueue;
+    double           m_pathRequestBudgetSeconds = 0.001;
+
+    // Tiles that stop rays (solid, not water) for the traversal kernels in TileRaycaster
+    mutable TileBitboard m_rayBlockedBits;
+    mutable uint32_t     m_rayBlockedBitsGeneration = 0;
+
+    // TraceScorpioLasers scratch, one ray per living scorpio
+    std::vector<Ray2>            m_laserRays;
+    std::vector<RaycastResult2D> m_laserResults;
+
+    // Shadowcast from the player's tile, recomputed when the player changes tile or tiles change. Its range
+    // covers every enemy's detect range, so HasLineOfSight toward the player is a lookup.
+    TileVisibilityField m_playerVisibility;
+    uint32_t            m_playerVisibilityGeneration = 0;
+    float               m_playerVisibilityRange      = 0.f;
+
+    // Tile-pair visibility over the ray-blocking terrain, built with the tiles (or taken from the snapshot)
+    // when m_visibilityTableRadius is positive and the map is small enough. Dropped once any ray-blocking
+    // tile changes.
+    static constexpr int MAX_VISIBILITY_TABLE_RADIUS = 64;
+
+    mutable TileVisibilityTable m_visibilityTable;
+    mutable uint32_t            m_visibilityTableGeneration = 0;
+    int                         m_visibilityTableRadius     = 0;
+
+    // Distance-field scratch, reused by every PopulateDistanceField* call
+    mutable TileBitboard  m_blockedBits;
+    mutable TileFloodFill m_tileFloodFill;
+
+    // One field shared by the wander-goal flood fallback and the F6 entity view, instead of one per entity
+    DistanceField* m_scratchDistanceField = nullptr;
 
     // MetaData management
-    std::vector<TileHeatMap*> m_tileHeatMaps;
-    Entity*                   m_currentSelectedEntity   = nullptr;
-    int                       m_currentTileHeatMapIndex = -1;
+    std::vector<DistanceField*> m_tileHeatMaps;                  // Debug-only, created on the first F6 press
+    uint32_t                    m_tileHeatMapsGeneration = 0;
+    mutable TileHeatMap*        m_debugDrawHeatMap       = nullptr;    // The selected field as floats, for AddVertsForDebugDraw
+    Entity*                     m_currentSelectedEntity   = nullptr;
+    int                         m_currentTileHeatMapIndex = -1;
 };
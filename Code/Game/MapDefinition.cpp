@@ -6,10 +6,20 @@
 #include "Game/MapDefinition.hpp"
 
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/IntVec2.hpp"
+#include "Game/DefinitionCache.hpp"
 
 //----------------------------------------------------------------------------------------------------
-std::vector<MapDefinition*> MapDefinition::s_mapDefinitions;
+namespace
+{
+    char const* MAP_DEFS_XML_PATH   = "Data/Definitions/MapDefinitions.xml";
+    char const* MAP_DEFS_CACHE_PATH = "Data/Cache/MapDefinitions.bin";
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<MapDefinition*>     MapDefinition::s_mapDefinitions;
+std::unordered_map<String, int> MapDefinition::s_mapDefIndexByName;
 
 //----------------------------------------------------------------------------------------------------
 MapDefinition::MapDefinition(XmlElement const& mapDefElement)
@@ -29,24 +39,90 @@ MapDefinition::MapDefinition(XmlElement const& mapDefElement)
     m_leoSpawnPercentage     = ParseXmlAttribute(mapDefElement, "leoSpawnPercentage", -1.f);
     m_ariesSpawnPercentage   = ParseXmlAttribute(mapDefElement, "ariesSpawnPercentage", -1.f);
     m_dimensions             = ParseXmlAttribute(mapDefElement, "dimensions", IntVec2(-1, -1));
+    m_snapshotFilePath       = ParseXmlAttribute(mapDefElement, "snapshot", "");
+
+
+    ResolveWormTileTypeIndices();
 }
 
 //----------------------------------------------------------------------------------------------------
-MapDefinition::~MapDefinition()
+// Field order must match WriteToCache. Worm tiles are cached by name, since tile indices can shift
+// whenever TileDefinitions.xml changes without MapDefinitions.xml changing.
+MapDefinition::MapDefinition(DefinitionCacheReader& reader)
 {
-    for (MapDefinition const* mapDef : s_mapDefinitions)
+    m_name                   = reader.ReadString();
+    m_index                  = reader.ReadInt();
+    m_worm01TileName         = reader.ReadString();
+    m_worm02TileName         = reader.ReadString();
+    m_worm03TileName         = reader.ReadString();
+    m_worm01Num              = reader.ReadInt();
+    m_worm02Num              = reader.ReadInt();
+    m_worm03Num              = reader.ReadInt();
+    m_worm01Length           = reader.ReadInt();
+    m_worm02Length           = reader.ReadInt();
+    m_worm03Length           = reader.ReadInt();
+    m_scorpioSpawnPercentage = reader.ReadFloat();
+    m_leoSpawnPercentage     = reader.ReadFloat();
+    m_ariesSpawnPercentage   = reader.ReadFloat();
+    m_dimensions             = reader.ReadIntVec2();
+    m_snapshotFilePath       = reader.ReadString();
+
+    if (reader.IsValid())
     {
-        delete mapDef;
+        ResolveWormTileTypeIndices();
     }
+}
 
-    s_mapDefinitions.clear();
+//----------------------------------------------------------------------------------------------------
+void MapDefinition::WriteToCache(DefinitionCacheWriter& writer) const
+{
+    writer.WriteString(m_name);
+    writer.WriteInt(m_index);
+    writer.WriteString(m_worm01TileName);
+    writer.WriteString(m_worm02TileName);
+    writer.WriteString(m_worm03TileName);
+    writer.WriteInt(m_worm01Num);
+    writer.WriteInt(m_worm02Num);
+    writer.WriteInt(m_worm03Num);
+    writer.WriteInt(m_worm01Length);
+    writer.WriteInt(m_worm02Length);
+    writer.WriteInt(m_worm03Length);
+    writer.WriteFloat(m_scorpioSpawnPercentage);
+    writer.WriteFloat(m_leoSpawnPercentage);
+    writer.WriteFloat(m_ariesSpawnPercentage);
+    writer.WriteIntVec2(m_dimensions);
+    writer.WriteString(m_snapshotFilePath);
 }
 
 //----------------------------------------------------------------------------------------------------
+void MapDefinition::ResolveWormTileTypeIndices()
+{
+    m_worm01TileTypeIndex = TileDefinition::GetTileTypeIndexByName(m_worm01TileName);
+    m_worm02TileTypeIndex = TileDefinition::GetTileTypeIndexByName(m_worm02TileName);
+    m_worm03TileTypeIndex = TileDefinition::GetTileTypeIndexByName(m_worm03TileName);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Safe to call again (e.g. on every new Game); the previous set is released first.
+// Loads from the baked cache when it matches the XML, otherwise parses the XML and re-bakes the cache.
 STATIC void MapDefinition::InitializeMapDefs()
 {
+    ClearMapDefs();
+
+    uint64_t sourceHash = 0;
+
+    if (!HashFileContents(MAP_DEFS_XML_PATH, sourceHash))
+    {
+        return;
+    }
+
+    if (LoadMapDefsFromCache(sourceHash))
+    {
+        return;
+    }
+
     XmlDocument mapDefXml;
-    if (mapDefXml.LoadFile("Data/Definitions/MapDefinitions.xml") != XmlResult::XML_SUCCESS)
+    if (mapDefXml.LoadFile(MAP_DEFS_XML_PATH) != XmlResult::XML_SUCCESS)
     {
         return;
     }
@@ -55,22 +131,89 @@ STATIC void MapDefinition::InitializeMapDefs()
     {
         for (XmlElement* element = root->FirstChildElement("MapDefinition"); element != nullptr; element = element->NextSiblingElement("MapDefinition"))
         {
-            MapDefinition* mapDef = new MapDefinition(*element);
-            s_mapDefinitions.push_back(mapDef);
+            RegisterMapDef(new MapDefinition(*element));
         }
     }
+
+    SaveMapDefsToCache(sourceHash);
 }
 
 //----------------------------------------------------------------------------------------------------
-STATIC MapDefinition const* MapDefinition::GetTileDefByName(String const& name)
+STATIC bool MapDefinition::LoadMapDefsFromCache(uint64_t const sourceHash)
 {
-    for (MapDefinition const* mapDef : s_mapDefinitions)
+    DefinitionCacheReader reader;
+
+    if (!reader.LoadFromFile(MAP_DEFS_CACHE_PATH, sourceHash))
+    {
+        return false;
+    }
+
+    int const numMapDefs = reader.ReadInt();
+
+    for (int mapDefIndex = 0; mapDefIndex < numMapDefs && reader.IsValid(); ++mapDefIndex)
     {
-        if (mapDef->m_name == name)
+        MapDefinition* mapDef = new MapDefinition(reader);
+
+        if (!reader.IsValid())
         {
-            return mapDef;
+            delete mapDef;
+            break;
         }
+
+        RegisterMapDef(mapDef);
+    }
+
+    if (reader.IsValid() && reader.IsAtEnd())
+    {
+        return true;
+    }
+
+    printf("WARNING: definition cache \"%s\" is corrupt, falling back to XML\n", MAP_DEFS_CACHE_PATH);
+    ClearMapDefs();
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void MapDefinition::SaveMapDefsToCache(uint64_t const sourceHash)
+{
+    DefinitionCacheWriter writer;
+
+    writer.WriteInt(static_cast<int>(s_mapDefinitions.size()));
+
+    for (MapDefinition const* mapDef : s_mapDefinitions)
+    {
+        mapDef->WriteToCache(writer);
     }
 
-    return nullptr;
+    writer.SaveToFile(MAP_DEFS_CACHE_PATH, sourceHash);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void MapDefinition::RegisterMapDef(MapDefinition* mapDef)
+{
+    s_mapDefIndexByName[mapDef->m_name] = static_cast<int>(s_mapDefinitions.size());
+    s_mapDefinitions.push_back(mapDef);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void MapDefinition::ClearMapDefs()
+{
+    for (MapDefinition const* mapDef : s_mapDefinitions)
+    {
+        delete mapDef;
+    }
+
+    s_mapDefinitions.clear();
+    s_mapDefIndexByName.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC MapDefinition const* MapDefinition::GetMapDefByName(String const& name)
+{
+    auto const found = s_mapDefIndexByName.find(name);
+
+    if (found == s_mapDefIndexByName.end()) return nullptr;
+
+    return s_mapDefinitions[found->second];
 }
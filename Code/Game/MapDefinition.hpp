@@ -4,26 +4,40 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <unordered_map>
 
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
+#include "Game/TileDefinition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class DefinitionCacheReader;
+class DefinitionCacheWriter;
 
 //----------------------------------------------------------------------------------------------------
 struct MapDefinition
 {
     explicit MapDefinition(XmlElement const& mapDefElement);
-    ~MapDefinition();
+    explicit MapDefinition(DefinitionCacheReader& reader);
+    ~MapDefinition() = default;
 
-    static void                        InitializeMapDefs();
-    static MapDefinition const*        GetTileDefByName(String const& name);
-    static std::vector<MapDefinition*> s_mapDefinitions;
+    void WriteToCache(DefinitionCacheWriter& writer) const;
 
-    String        GetName() const { return m_name; }
+    static void                            InitializeMapDefs();
+    static void                            ClearMapDefs();
+    static MapDefinition const*            GetMapDefByName(String const& name);
+    static std::vector<MapDefinition*>     s_mapDefinitions;
+    static std::unordered_map<String, int> s_mapDefIndexByName;
+
+    String const& GetName() const { return m_name; }
     int           GetIndex() const { return m_index; }
     String const& GetWorm01TileName() const { return m_worm01TileName; }
     String const& GetWorm02TileName() const { return m_worm02TileName; }
     String const& GetWorm03TileName() const { return m_worm03TileName; }
+    TileTypeIndex GetWorm01TileTypeIndex() const { return m_worm01TileTypeIndex; }
+    TileTypeIndex GetWorm02TileTypeIndex() const { return m_worm02TileTypeIndex; }
+    TileTypeIndex GetWorm03TileTypeIndex() const { return m_worm03TileTypeIndex; }
     int           GetWorm01Num() const { return m_worm01Num; }
     int           GetWorm02Num() const { return m_worm02Num; }
     int           GetWorm03Num() const { return m_worm03Num; }
@@ -34,21 +48,31 @@ struct MapDefinition
     float         GetLeoSpawnPercentage() const { return m_leoSpawnPercentage; }
     float         GetAriesSpawnPercentage() const { return m_ariesSpawnPercentage; }
     IntVec2       GetDimensions() const { return m_dimensions; }
+    String const& GetSnapshotFilePath() const { return m_snapshotFilePath; }
 
 private:
-    String  m_name;
-    int     m_index = 0;
-    String  m_worm01TileName;
-    String  m_worm02TileName;
-    String  m_worm03TileName;
-    int     m_worm01Num              = 0;
-    int     m_worm02Num              = 0;
-    int     m_worm03Num              = 0;
-    int     m_worm01Length           = 0;
-    int     m_worm02Length           = 0;
-    int     m_worm03Length           = 0;
-    float   m_scorpioSpawnPercentage = 0.f;
-    float   m_leoSpawnPercentage     = 0.f;
-    float   m_ariesSpawnPercentage   = 0.f;
-    IntVec2 m_dimensions             = IntVec2::ZERO;
+    static bool LoadMapDefsFromCache(uint64_t sourceHash);
+    static void SaveMapDefsToCache(uint64_t sourceHash);
+    static void RegisterMapDef(MapDefinition* mapDef);
+    void        ResolveWormTileTypeIndices();
+
+    String        m_name;
+    int           m_index = 0;
+    String        m_worm01TileName;
+    String        m_worm02TileName;
+    String        m_worm03TileName;
+    TileTypeIndex m_worm01TileTypeIndex    = 0;    // Resolved from the names at load, so TileDefinitions must be loaded first
+    TileTypeIndex m_worm02TileTypeIndex    = 0;
+    TileTypeIndex m_worm03TileTypeIndex    = 0;
+    int           m_worm01Num              = 0;
+    int           m_worm02Num              = 0;
+    int           m_worm03Num              = 0;
+    int           m_worm01Length           = 0;
+    int           m_worm02Length           = 0;
+    int           m_worm03Length           = 0;
+    float         m_scorpioSpawnPercentage = 0.f;
+    float         m_leoSpawnPercentage     = 0.f;
+    float         m_ariesSpawnPercentage   = 0.f;
+    IntVec2       m_dimensions             = IntVec2::ZERO;
+    String        m_snapshotFilePath;    // Opt-in: a snapshot that replaces generation; empty means generate
 };
@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------
+// MapSnapshot.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/MapSnapshot.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "Game/DefinitionCache.hpp"
+#include "Game/TileDefinition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The tile section is padded so the float heat maps that follow stay 4-byte aligned in the view
+size_t GetMapSnapshotTilesSize(int const numTiles)
+{
+    size_t const numTileBytes = static_cast<size_t>(numTiles) * sizeof(TileTypeIndex);
+
+    return (numTileBytes + 3) & ~static_cast<size_t>(3);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t ComputeTileDefinitionsHash()
+{
+    String allTileNames;
+
+    for (String const& tileName : TileDefinition::GetTileNames())
+    {
+        allTileNames += tileName;
+        allTileNames += '\n';
+    }
+
+    return HashBytesFNV1a(reinterpret_cast<unsigned char const*>(allTileNames.data()), allTileNames.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+MappedFileView::~MappedFileView()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MappedFileView::Open(char const* filePath)
+{
+    Close();
+
+    HANDLE const fileHandle = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    m_fileHandle = fileHandle;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (m_mappingHandle == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<unsigned char const*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+    if (m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MappedFileView::Close()
+{
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mappingHandle) CloseHandle(m_mappingHandle);
+    if (m_fileHandle) CloseHandle(m_fileHandle);
+
+    m_data          = nullptr;
+    m_mappingHandle = nullptr;
+    m_fileHandle    = nullptr;
+    m_size          = 0;
+}
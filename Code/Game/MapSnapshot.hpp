@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------------------------------
+// MapSnapshot.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// Binary snapshot of a fully generated Map, laid out so it can be read straight out of a mapped view:
+//
+//   MapSnapshotHeader
+//   TileTypeIndex    tiles[dimensions.x * dimensions.y]        (row-major, padded to 4 bytes)
+//   uint16_t         heatMaps[numHeatMaps][dimensions.x * dimensions.y]     (DistanceField values)
+//   MapSnapshotSpawn spawns[numSpawns]
+//   uint64_t         visibilityTable[numVisibilityTableWords]    (TileVisibilityTable words, may be empty)
+//
+// Tile type indices are only meaningful for the TileDefinitions the snapshot was saved with, so the
+// header records a hash of the tile names in index order. Bump MAP_SNAPSHOT_VERSION on any layout change.
+//
+constexpr uint32_t MAP_SNAPSHOT_MAGIC   = 0x534D4C44;    // "DLMS"
+constexpr uint32_t MAP_SNAPSHOT_VERSION = 3;
+
+//----------------------------------------------------------------------------------------------------
+struct MapSnapshotHeader
+{
+    uint32_t m_magic               = MAP_SNAPSHOT_MAGIC;
+    uint32_t m_version             = MAP_SNAPSHOT_VERSION;
+    uint64_t m_tileDefinitionsHash = 0;
+    int32_t  m_dimensionsX         = 0;
+    int32_t  m_dimensionsY         = 0;
+    int32_t  m_startX              = 0;
+    int32_t  m_startY              = 0;
+    int32_t  m_exitX               = 0;
+    int32_t  m_exitY               = 0;
+    uint32_t m_numHeatMaps         = 0;
+    uint32_t m_numSpawns           = 0;
+    int32_t  m_visibilityTableRadius   = 0;    // 0 when no table was saved
+    uint32_t m_numVisibilityTableWords = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct MapSnapshotSpawn
+{
+    int32_t m_type               = 0;    // EntityType
+    int32_t m_faction            = 0;    // EntityFaction
+    float   m_positionX          = 0.f;
+    float   m_positionY          = 0.f;
+    float   m_orientationDegrees = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+size_t   GetMapSnapshotTilesSize(int numTiles);
+uint64_t ComputeTileDefinitionsHash();
+
+//----------------------------------------------------------------------------------------------------
+// Read-only view of a whole file mapped into memory; the data stays valid until Close() or destruction
+class MappedFileView
+{
+public:
+    MappedFileView() = default;
+    ~MappedFileView();
+
+    MappedFileView(MappedFileView const&)            = delete;
+    MappedFileView& operator=(MappedFileView const&) = delete;
+
+    bool Open(char const* filePath);
+    void Close();
+
+    unsigned char const* GetData() const { return m_data; }
+    size_t               GetSize() const { return m_size; }
+
+private:
+    void*                m_fileHandle    = nullptr;
+    void*                m_mappingHandle = nullptr;
+    unsigned char const* m_data          = nullptr;
+    size_t               m_size          = 0;
+};
@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------
+// PathRequestQueue.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/PathRequestQueue.hpp"
+
+#include <utility>
+
+//----------------------------------------------------------------------------------------------------
+// Returns the handle to collect the result under; a pending handle comes back unchanged, anything else
+// (invalid, already solved) is dropped for a fresh one
+PathRequestHandle PathRequestQueue::Submit(PathRequestHandle const handle, PathRequest const& request)
+{
+    for (PathRequest& pending : m_pending)
+    {
+        if (handle == INVALID_PATH_REQUEST_HANDLE || pending.m_handle != handle) continue;
+
+        pending          = request;
+        pending.m_handle = handle;
+        return handle;
+    }
+
+    Cancel(handle);
+
+    PathRequest& pending = m_pending.emplace_back(request);
+    pending.m_handle     = m_nextHandle++;
+
+    if (m_nextHandle == INVALID_PATH_REQUEST_HANDLE) m_nextHandle = 1;
+
+    return pending.m_handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PathRequestQueue::PopPending(PathRequest& out_request)
+{
+    if (m_pending.empty()) return false;
+
+    out_request = m_pending.front();
+    m_pending.pop_front();
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Takes over path's storage
+void PathRequestQueue::Complete(PathRequestHandle const handle, std::vector<Vec2>& path)
+{
+    PathResult& result = m_results.emplace_back();
+
+    result.m_handle = handle;
+    result.m_path.swap(path);
+}
+
+//----------------------------------------------------------------------------------------------------
+// True once the request is solved; the result is handed over and the handle is spent
+bool PathRequestQueue::TakeResult(PathRequestHandle const handle, std::vector<Vec2>& out_path)
+{
+    for (size_t resultIndex = 0; resultIndex < m_results.size(); ++resultIndex)
+    {
+        if (m_results[resultIndex].m_handle != handle) continue;
+
+        out_path.swap(m_results[resultIndex].m_path);
+        m_results[resultIndex] = std::move(m_results.back());
+        m_results.pop_back();
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Drops the request whether it is still pending or already solved
+void PathRequestQueue::Cancel(PathRequestHandle const handle)
+{
+    if (handle == INVALID_PATH_REQUEST_HANDLE) return;
+
+    for (std::deque<PathRequest>::iterator it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+        if (it->m_handle != handle) continue;
+
+        m_pending.erase(it);
+        return;
+    }
+
+    std::vector<Vec2> discardedPath;
+    TakeResult(handle, discardedPath);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PathRequestQueue::Clear()
+{
+    m_pending.clear();
+    m_results.clear();
+}
@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------------------------------
+// PathRequestQueue.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Engine/Math/Vec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum TilePassability : int;    // Map.hpp
+
+typedef uint32_t PathRequestHandle;
+
+PathRequestHandle constexpr INVALID_PATH_REQUEST_HANDLE = 0;
+
+//----------------------------------------------------------------------------------------------------
+struct PathRequest
+{
+    PathRequestHandle m_handle      = INVALID_PATH_REQUEST_HANDLE;
+    Vec2              m_start       = Vec2::ZERO;
+    Vec2              m_goal        = Vec2::ZERO;
+    TilePassability   m_passability = {};
+    bool              m_isChasing   = false;    // Chasers follow the shared flow field, wanderers get a search
+};
+
+//----------------------------------------------------------------------------------------------------
+// Path requests waiting to be solved, and solved paths waiting to be collected. The queue only does the
+// bookkeeping; the Map drains it within a per-frame time budget. Resubmitting under a handle that is
+// still pending re-aims that request in place, so a requester never has more than one in flight.
+//
+class PathRequestQueue
+{
+public:
+    PathRequestHandle Submit(PathRequestHandle handle, PathRequest const& request);
+    bool              PopPending(PathRequest& out_request);
+    void              Complete(PathRequestHandle handle, std::vector<Vec2>& path);
+    bool              TakeResult(PathRequestHandle handle, std::vector<Vec2>& out_path);
+    void              Cancel(PathRequestHandle handle);
+    void              Clear();
+
+    int GetNumPending() const { return static_cast<int>(m_pending.size()); }
+
+private:
+    struct PathResult
+    {
+        PathRequestHandle m_handle = INVALID_PATH_REQUEST_HANDLE;
+        std::vector<Vec2> m_path;
+    };
+
+    std::deque<PathRequest> m_pending;    // Oldest first
+    std::vector<PathResult> m_results;
+    PathRequestHandle       m_nextHandle = 1;
+};
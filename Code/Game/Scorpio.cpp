@@ -155,12 +155,18 @@ void Scorpio::RenderTurret() const
     g_renderer->DrawVertexArray(static_cast<int>(turretVerts.size()), turretVerts.data());
 }
 
+//----------------------------------------------------------------------------------------------------
+Ray2 Scorpio::GetLaserRay() const
+{
+    Vec2 const fwdNormal = Vec2::MakeFromPolarDegrees(m_turretOrientationDegrees);
+
+    return Ray2(m_position, fwdNormal.GetNormalized(), 10000);
+}
+
 //----------------------------------------------------------------------------------------------------
 void Scorpio::RenderLaser() const
 {
-    Vec2 const            fwdNormal       = Vec2::MakeFromPolarDegrees(m_turretOrientationDegrees);
-    Ray2 const            ray             = Ray2(m_position, fwdNormal.GetNormalized(), 10000);
-    RaycastResult2D const raycastResult2D = m_map->RaycastVsTiles(ray);
+    Vec2 const fwdNormal = Vec2::MakeFromPolarDegrees(m_turretOrientationDegrees);
 
-    DebugDrawLine(m_position + fwdNormal * 0.45f, raycastResult2D.m_impactPosition, 0.05f, Rgba8::RED);
+    DebugDrawLine(m_position + fwdNormal * 0.45f, m_laserImpactPosition, 0.05f, Rgba8::RED);
 }
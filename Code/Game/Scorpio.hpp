@@ -6,6 +6,7 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
 #include "Game/Entity.hpp"
 #include "Game/GameCommon.hpp"
 
@@ -22,6 +23,10 @@ public:
     void Render() const override;
     void DebugRender() const override;
 
+    // Map traces every scorpio's laser in one batch after the update; RenderLaser draws the stored impact
+    Ray2 GetLaserRay() const;
+    void SetLaserImpactPosition(Vec2 const& impactPosition) { m_laserImpactPosition = impactPosition; }
+
 private:
     void UpdateTurret(float deltaSeconds);
     void RenderBody() const;
@@ -31,6 +36,7 @@ private:
     AABB2    m_turretBounds             = AABB2::NEG_HALF_TO_HALF;
     Texture* m_turretTexture            = nullptr;
     float    m_turretOrientationDegrees = 0.f;
+    Vec2     m_laserImpactPosition      = Vec2::ZERO;
     float    m_shootCoolDown            = 0.f;
     float    m_turretRotateSpeed        = g_gameConfigBlackboard.GetValue("scorpioTurretRotateSpeed", 90.f);
     float    m_shootDegreesThreshold    = g_gameConfigBlackboard.GetValue("scorpioShootDegreesThreshold", 5.f);
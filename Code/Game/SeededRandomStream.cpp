@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------------------------------
+// SeededRandomStream.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/SeededRandomStream.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+SeededRandomStream::SeededRandomStream(unsigned int const seed)
+{
+    Reset(seed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SeededRandomStream::Reset(unsigned int const seed)
+{
+    m_seed     = seed;
+    m_position = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int SeededRandomStream::RollRandomUInt()
+{
+    return Squirrel3(m_position++, m_seed);
+}
+
+//----------------------------------------------------------------------------------------------------
+int SeededRandomStream::RollRandomIntInRange(int const minInclusive, int const maxInclusive)
+{
+    unsigned int const range = static_cast<unsigned int>(maxInclusive - minInclusive) + 1u;
+
+    if (range == 0u) return minInclusive + static_cast<int>(RollRandomUInt());
+
+    return minInclusive + static_cast<int>(RollRandomUInt() % range);
+}
+
+//----------------------------------------------------------------------------------------------------
+float SeededRandomStream::RollRandomFloatZeroToOne()
+{
+    constexpr double ONE_OVER_MAX_UINT = 1.0 / 4294967295.0;
+
+    return static_cast<float>(static_cast<double>(RollRandomUInt()) * ONE_OVER_MAX_UINT);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Squirrel Eiserloh's "Squirrel3" positional noise hash
+STATIC unsigned int SeededRandomStream::Squirrel3(int const position, unsigned int const seed)
+{
+    constexpr unsigned int BIT_NOISE1 = 0x68E31DA4;
+    constexpr unsigned int BIT_NOISE2 = 0xB5297A4D;
+    constexpr unsigned int BIT_NOISE3 = 0x1B56C4E9;
+
+    unsigned int mangledBits = static_cast<unsigned int>(position);
+    mangledBits *= BIT_NOISE1;
+    mangledBits += seed;
+    mangledBits ^= (mangledBits >> 8);
+    mangledBits += BIT_NOISE2;
+    mangledBits ^= (mangledBits << 8);
+    mangledBits *= BIT_NOISE3;
+    mangledBits ^= (mangledBits >> 8);
+
+    return mangledBits;
+}
@@ -0,0 +1,31 @@
+//----------------------------------------------------------------------------------------------------
+// SeededRandomStream.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+// Deterministic random stream for map generation: roll N is Squirrel3(N, seed), so each Map owns an
+// independent stream and gets identical results no matter which thread generates it or when.
+// Gameplay randomness stays on g_rng.
+//
+class SeededRandomStream
+{
+public:
+    SeededRandomStream() = default;
+    explicit SeededRandomStream(unsigned int seed);
+
+    void         Reset(unsigned int seed);
+    unsigned int GetSeed() const { return m_seed; }
+
+    unsigned int RollRandomUInt();
+    int          RollRandomIntInRange(int minInclusive, int maxInclusive);
+    float        RollRandomFloatZeroToOne();
+
+    static unsigned int Squirrel3(int position, unsigned int seed);
+
+private:
+    unsigned int m_seed     = 0;
+    int          m_position = 0;
+};
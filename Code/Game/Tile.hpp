@@ -5,13 +5,12 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 
-#include "Engine/Core/StringUtils.hpp"
-#include "Engine/Math/IntVec2.hpp"
+#include "Game/TileDefinition.hpp"
 
 //----------------------------------------------------------------------------------------------------
 // "Flyweight" design pattern ( each tile only knows its type )
+// Coords are implied by the tile's position in its TileChunkGrid chunk
 struct Tile
 {
-    IntVec2 m_coords = IntVec2(-1, -1);
-    String  m_name;
+    TileTypeIndex m_typeIndex = 0;
 };
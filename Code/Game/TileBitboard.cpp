@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------------------------------
+// TileBitboard.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileBitboard.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+TileBitboard::TileBitboard(IntVec2 const& dimensions)
+{
+    Resize(dimensions);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileBitboard::Resize(IntVec2 const& dimensions)
+{
+    m_dimensions  = dimensions;
+    m_wordsPerRow = (dimensions.x + 63) / 64;
+    m_words.assign(static_cast<size_t>(m_wordsPerRow) * static_cast<size_t>(dimensions.y), 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileBitboard::ClearAll()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sets or clears every tile; padding bits past m_dimensions.x stay zero
+void TileBitboard::FillAll(bool const value)
+{
+    if (!value)
+    {
+        ClearAll();
+        return;
+    }
+
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        uint64_t* row = &m_words[static_cast<size_t>(tileY) * m_wordsPerRow];
+
+        for (int wordIndex = 0; wordIndex < m_wordsPerRow; ++wordIndex)
+        {
+            row[wordIndex] = GetValidBitsMask(wordIndex);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileBitboard::IsSet(int const tileX, int const tileY) const
+{
+    uint64_t const word = m_words[static_cast<size_t>(tileY) * m_wordsPerRow + (tileX >> 6)];
+
+    return (word >> (tileX & 63) & 1) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileBitboard::Set(int const tileX, int const tileY)
+{
+    m_words[static_cast<size_t>(tileY) * m_wordsPerRow + (tileX >> 6)] |= uint64_t(1) << (tileX & 63);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileBitboard::Clear(int const tileX, int const tileY)
+{
+    m_words[static_cast<size_t>(tileY) * m_wordsPerRow + (tileX >> 6)] &= ~(uint64_t(1) << (tileX & 63));
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileBitboard::SetTo(int const tileX, int const tileY, bool const value)
+{
+    if (value) Set(tileX, tileY);
+    else Clear(tileX, tileY);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Inclusive rect, clamped to the board; tests each covered row a word at a time
+bool TileBitboard::IsAnySetInRect(IntVec2 const& mins, IntVec2 const& maxs) const
+{
+    int const minX = mins.x < 0 ? 0 : mins.x;
+    int const minY = mins.y < 0 ? 0 : mins.y;
+    int const maxX = maxs.x >= m_dimensions.x ? m_dimensions.x - 1 : maxs.x;
+    int const maxY = maxs.y >= m_dimensions.y ? m_dimensions.y - 1 : maxs.y;
+
+    if (minX > maxX || minY > maxY) return false;
+
+    int const firstWord = minX >> 6;
+    int const lastWord  = maxX >> 6;
+
+    for (int tileY = minY; tileY <= maxY; ++tileY)
+    {
+        uint64_t const* row = GetRow(tileY);
+
+        for (int wordIndex = firstWord; wordIndex <= lastWord; ++wordIndex)
+        {
+            uint64_t mask = ~uint64_t(0);
+
+            if (wordIndex == firstWord) mask &= ~uint64_t(0) << (minX & 63);
+            if (wordIndex == lastWord) mask &= ~uint64_t(0) >> (63 - (maxX & 63));
+
+            if ((row[wordIndex] & mask) != 0) return true;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Mask of bits in a row word that map to real tiles (the last word of a row may be partial)
+uint64_t TileBitboard::GetValidBitsMask(int const wordIndex) const
+{
+    int const remainingBits = m_dimensions.x - (wordIndex << 6);
+
+    if (remainingBits >= 64) return ~uint64_t(0);
+
+    return (uint64_t(1) << remainingBits) - 1;
+}
@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// TileBitboard.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// One bit per tile, rows padded to whole 64-bit words so a row can be tested a word at a time.
+// Padding bits past m_dimensions.x are always zero.
+//
+class TileBitboard
+{
+public:
+    TileBitboard() = default;
+    explicit TileBitboard(IntVec2 const& dimensions);
+
+    void Resize(IntVec2 const& dimensions);
+    void ClearAll();
+    void FillAll(bool value);
+
+    bool IsSet(int tileX, int tileY) const;
+    bool IsSet(IntVec2 const& tileCoords) const { return IsSet(tileCoords.x, tileCoords.y); }
+    void Set(int tileX, int tileY);
+    void Clear(int tileX, int tileY);
+    void SetTo(int tileX, int tileY, bool value);
+    bool IsAnySetInRect(IntVec2 const& mins, IntVec2 const& maxs) const;
+
+    uint64_t const* GetRow(int tileY) const { return &m_words[static_cast<size_t>(tileY) * m_wordsPerRow]; }
+    uint64_t*       GetRow(int tileY) { return &m_words[static_cast<size_t>(tileY) * m_wordsPerRow]; }
+    uint64_t        GetValidBitsMask(int wordIndex) const;
+    int             GetWordsPerRow() const { return m_wordsPerRow; }
+    IntVec2         GetDimensions() const { return m_dimensions; }
+
+private:
+    IntVec2               m_dimensions  = IntVec2::ZERO;
+    int                   m_wordsPerRow = 0;
+    std::vector<uint64_t> m_words;
+};
@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------------------------------
+// TileChunkGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileChunkGrid.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+void TileChunkGrid::Resize(IntVec2 const& dimensions, TileTypeIndex const fillTypeIndex)
+{
+    m_dimensions      = dimensions;
+    m_chunkDimensions = IntVec2((dimensions.x + CHUNK_SIZE_MASK) >> CHUNK_SIZE_SHIFT,
+                                (dimensions.y + CHUNK_SIZE_MASK) >> CHUNK_SIZE_SHIFT);
+
+    m_chunks.clear();
+    m_chunks.resize(static_cast<size_t>(m_chunkDimensions.x) * static_cast<size_t>(m_chunkDimensions.y));
+
+    FillAll(fillTypeIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Collapses every chunk back to uniform, releasing all tile arrays
+void TileChunkGrid::FillAll(TileTypeIndex const tileTypeIndex)
+{
+    for (Chunk& chunk : m_chunks)
+    {
+        std::vector<Tile>().swap(chunk.m_tiles);
+        chunk.m_uniformTypeIndex = tileTypeIndex;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Releases the tile array of any chunk whose in-bounds tiles have ended up holding a single type
+void TileChunkGrid::Compact()
+{
+    for (int chunkY = 0; chunkY < m_chunkDimensions.y; ++chunkY)
+    {
+        for (int chunkX = 0; chunkX < m_chunkDimensions.x; ++chunkX)
+        {
+            Chunk& chunk = m_chunks[chunkY * m_chunkDimensions.x + chunkX];
+
+            if (chunk.IsUniform()) continue;
+
+            // Chunks on the ragged map edge hold padding tiles that are never written, so skip them
+            int const           numTilesX      = std::min(CHUNK_SIZE, m_dimensions.x - (chunkX << CHUNK_SIZE_SHIFT));
+            int const           numTilesY      = std::min(CHUNK_SIZE, m_dimensions.y - (chunkY << CHUNK_SIZE_SHIFT));
+            TileTypeIndex const firstTypeIndex = chunk.m_tiles[0].m_typeIndex;
+            bool                isUniform      = true;
+
+            for (int localY = 0; localY < numTilesY && isUniform; ++localY)
+            {
+                for (int localX = 0; localX < numTilesX; ++localX)
+                {
+                    if (chunk.m_tiles[(localY << CHUNK_SIZE_SHIFT) + localX].m_typeIndex != firstTypeIndex)
+                    {
+                        isUniform = false;
+                        break;
+                    }
+                }
+            }
+
+            if (!isUniform) continue;
+
+            std::vector<Tile>().swap(chunk.m_tiles);
+            chunk.m_uniformTypeIndex = firstTypeIndex;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TileTypeIndex TileChunkGrid::GetTileTypeIndex(int const tileX, int const tileY) const
+{
+    Chunk const& chunk = GetChunk(tileX, tileY);
+
+    if (chunk.IsUniform()) return chunk.m_uniformTypeIndex;
+
+    return chunk.m_tiles[((tileY & CHUNK_SIZE_MASK) << CHUNK_SIZE_SHIFT) + (tileX & CHUNK_SIZE_MASK)].m_typeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileChunkGrid::SetTileTypeIndex(int const tileX, int const tileY, TileTypeIndex const tileTypeIndex)
+{
+    Chunk& chunk = GetChunk(tileX, tileY);
+
+    if (chunk.IsUniform())
+    {
+        if (chunk.m_uniformTypeIndex == tileTypeIndex) return;
+
+        // First differing write; the chunk is always allocated full-size, even at the ragged map edge
+        chunk.m_tiles.assign(CHUNK_SIZE * CHUNK_SIZE, Tile{chunk.m_uniformTypeIndex});
+    }
+
+    chunk.m_tiles[((tileY & CHUNK_SIZE_MASK) << CHUNK_SIZE_SHIFT) + (tileX & CHUNK_SIZE_MASK)].m_typeIndex = tileTypeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileChunkGrid::GetNumAllocatedChunks() const
+{
+    int numAllocatedChunks = 0;
+
+    for (Chunk const& chunk : m_chunks)
+    {
+        if (!chunk.IsUniform()) ++numAllocatedChunks;
+    }
+
+    return numAllocatedChunks;
+}
@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------------------------------------
+// TileChunkGrid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Tile storage split into CHUNK_SIZE x CHUNK_SIZE chunks. A chunk whose tiles all share one type is
+// "uniform" and stores only that type; its tile array is allocated on the first differing write and
+// released again by Compact(), so memory scales with map content rather than map area.
+//
+class TileChunkGrid
+{
+public:
+    static constexpr int CHUNK_SIZE_SHIFT = 5;
+    static constexpr int CHUNK_SIZE       = 1 << CHUNK_SIZE_SHIFT;
+    static constexpr int CHUNK_SIZE_MASK  = CHUNK_SIZE - 1;
+
+    TileChunkGrid() = default;
+
+    void Resize(IntVec2 const& dimensions, TileTypeIndex fillTypeIndex);
+    void FillAll(TileTypeIndex tileTypeIndex);
+    void Compact();
+
+    TileTypeIndex GetTileTypeIndex(int tileX, int tileY) const;
+    void          SetTileTypeIndex(int tileX, int tileY, TileTypeIndex tileTypeIndex);
+
+    IntVec2 GetDimensions() const { return m_dimensions; }
+    IntVec2 GetChunkDimensions() const { return m_chunkDimensions; }
+    int     GetNumAllocatedChunks() const;
+    int     GetNumChunks() const { return static_cast<int>(m_chunks.size()); }
+
+private:
+    struct Chunk
+    {
+        std::vector<Tile> m_tiles;                  // Empty while the chunk is uniform
+        TileTypeIndex     m_uniformTypeIndex = 0;
+
+        bool IsUniform() const { return m_tiles.empty(); }
+    };
+
+    Chunk&       GetChunk(int tileX, int tileY) { return m_chunks[(tileY >> CHUNK_SIZE_SHIFT) * m_chunkDimensions.x + (tileX >> CHUNK_SIZE_SHIFT)]; }
+    Chunk const& GetChunk(int tileX, int tileY) const { return m_chunks[(tileY >> CHUNK_SIZE_SHIFT) * m_chunkDimensions.x + (tileX >> CHUNK_SIZE_SHIFT)]; }
+
+    IntVec2            m_dimensions      = IntVec2::ZERO;
+    IntVec2            m_chunkDimensions = IntVec2::ZERO;
+    std::vector<Chunk> m_chunks;
+};
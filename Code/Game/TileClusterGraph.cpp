@@ -0,0 +1,580 @@
+//----------------------------------------------------------------------------------------------------
+// TileClusterGraph.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileClusterGraph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+#include "Game/DistanceField.hpp"
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Open runs shorter than this get one entrance in the middle, longer ones one at each end
+    constexpr int MIN_TWO_ENTRANCE_RUN = 6;
+
+    // Lower f first; on ties the deeper node, as in TilePathfinder
+    bool IsWorseOpenEntry(int const estimatedCostA, int const costA, int const estimatedCostB, int const costB)
+    {
+        if (estimatedCostA != estimatedCostB) return estimatedCostA > estimatedCostB;
+
+        return costA < costB;
+    }
+
+    IntVec2 GetBorderCoords(IntVec2 const& borderStart, IntVec2 const& step, int const borderIndex)
+    {
+        return IntVec2(borderStart.x + step.x * borderIndex, borderStart.y + step.y * borderIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileClusterGraph::Build(TileBitboard const& blockedBits)
+{
+    m_dimensions  = blockedBits.GetDimensions();
+    m_numClusters = IntVec2((m_dimensions.x + CLUSTER_SIZE - 1) / CLUSTER_SIZE,
+                            (m_dimensions.y + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+
+    int const numTiles = m_dimensions.x * m_dimensions.y;
+
+    m_clusters.assign(static_cast<size_t>(m_numClusters.x) * static_cast<size_t>(m_numClusters.y), Cluster());
+    m_tileNodeIndices.assign(numTiles, -1);
+    m_floodDistances.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+    m_floodParents.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+    m_floodQueue.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+    m_nodeStamps.assign(numTiles + 2, 0);
+    m_nodeCosts.resize(numTiles + 2);
+    m_nodeParents.resize(numTiles + 2);
+    m_searchStamp = 0;
+
+    for (int clusterY = 0; clusterY < m_numClusters.y; ++clusterY)
+    {
+        for (int clusterX = 0; clusterX < m_numClusters.x; ++clusterX)
+        {
+            Cluster& cluster = m_clusters[clusterY * m_numClusters.x + clusterX];
+
+            cluster.m_mins = IntVec2(clusterX * CLUSTER_SIZE, clusterY * CLUSTER_SIZE);
+            cluster.m_maxs = IntVec2(std::min(cluster.m_mins.x + CLUSTER_SIZE, m_dimensions.x) - 1,
+                                     std::min(cluster.m_mins.y + CLUSTER_SIZE, m_dimensions.y) - 1);
+        }
+    }
+
+    for (int clusterIndex = 0; clusterIndex < static_cast<int>(m_clusters.size()); ++clusterIndex)
+    {
+        RebuildCluster(blockedBits, clusterIndex);
+    }
+
+    LabelComponents();
+}
+
+//----------------------------------------------------------------------------------------------------
+// A changed tile can move entrances on any border of its own cluster, and an entrance adds nodes on
+// both sides of its border, so the clusters around the changed ones are rebuilt as well
+void TileClusterGraph::Update(TileBitboard const& blockedBits, IntVec2 const& changedMins, IntVec2 const& changedMaxs)
+{
+    if (!IsBuilt() || blockedBits.GetDimensions() != m_dimensions)
+    {
+        Build(blockedBits);
+        return;
+    }
+
+    int const minClusterX = std::max(changedMins.x - 1, 0) / CLUSTER_SIZE;
+    int const minClusterY = std::max(changedMins.y - 1, 0) / CLUSTER_SIZE;
+    int const maxClusterX = std::min(changedMaxs.x + 1, m_dimensions.x - 1) / CLUSTER_SIZE;
+    int const maxClusterY = std::min(changedMaxs.y + 1, m_dimensions.y - 1) / CLUSTER_SIZE;
+
+    for (int clusterY = std::max(minClusterY - 1, 0); clusterY <= std::min(maxClusterY + 1, m_numClusters.y - 1); ++clusterY)
+    {
+        for (int clusterX = std::max(minClusterX - 1, 0); clusterX <= std::min(maxClusterX + 1, m_numClusters.x - 1); ++clusterX)
+        {
+            RebuildCluster(blockedBits, clusterY * m_numClusters.x + clusterX);
+        }
+    }
+
+    LabelComponents();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Fills out_tilePath with the tiles from start to goal, both included. Returns false, leaving it empty,
+// if the goal cannot be reached. Unlike TilePathfinder both ends must be open: a blocked start or goal on
+// a cluster border would cross it without an entrance.
+bool TileClusterGraph::FindPath(TileBitboard const&   blockedBits,
+                                IntVec2 const&        startCoords,
+                                IntVec2 const&        goalCoords,
+                                std::vector<IntVec2>& out_tilePath)
+{
+    out_tilePath.clear();
+    m_numExpandedNodes = 0;
+
+    if (!IsBuilt() || blockedBits.GetDimensions() != m_dimensions) return false;
+    if (startCoords.x < 0 || startCoords.x >= m_dimensions.x || startCoords.y < 0 || startCoords.y >= m_dimensions.y) return false;
+    if (goalCoords.x < 0 || goalCoords.x >= m_dimensions.x || goalCoords.y < 0 || goalCoords.y >= m_dimensions.y) return false;
+    if (blockedBits.IsSet(startCoords) || blockedBits.IsSet(goalCoords)) return false;
+
+    if (++m_searchStamp == 0)
+    {
+        std::fill(m_nodeStamps.begin(), m_nodeStamps.end(), 0);
+        m_searchStamp = 1;
+    }
+
+    int const numTiles     = m_dimensions.x * m_dimensions.y;
+    int const virtualStart = numTiles;
+    int const virtualGoal  = numTiles + 1;
+    int const startTile    = startCoords.y * m_dimensions.x + startCoords.x;
+    int const goalTile     = goalCoords.y * m_dimensions.x + goalCoords.x;
+    int const startCluster = GetClusterIndex(startCoords.x, startCoords.y);
+    int const goalCluster  = GetClusterIndex(goalCoords.x, goalCoords.y);
+
+    auto const getHeuristic = [&](int const tileIndex)
+    {
+        return std::abs(tileIndex % m_dimensions.x - goalCoords.x) + std::abs(tileIndex / m_dimensions.x - goalCoords.y);
+    };
+
+    // Goal cluster nodes to the goal, then start to start cluster nodes (and straight to the goal if it is there)
+    Cluster const& goalClusterData = m_clusters[goalCluster];
+
+    FloodCluster(blockedBits, goalCluster, goalTile);
+    m_goalNodeDistances.resize(goalClusterData.m_nodeTiles.size());
+
+    for (size_t nodeIndex = 0; nodeIndex < goalClusterData.m_nodeTiles.size(); ++nodeIndex)
+    {
+        m_goalNodeDistances[nodeIndex] = static_cast<uint16_t>(GetFloodDistance(goalCluster, goalClusterData.m_nodeTiles[nodeIndex]));
+    }
+
+    m_openHeap.clear();
+    m_nodeStamps[virtualStart]  = m_searchStamp;
+    m_nodeCosts[virtualStart]   = 0;
+    m_nodeParents[virtualStart] = -1;
+
+    FloodCluster(blockedBits, startCluster, startTile);
+
+    for (int const nodeTile : m_clusters[startCluster].m_nodeTiles)
+    {
+        int const distance = GetFloodDistance(startCluster, nodeTile);
+
+        if (distance != DistanceField::UNREACHABLE) Relax(nodeTile, distance, virtualStart, distance + getHeuristic(nodeTile));
+    }
+
+    if (startCluster == goalCluster)
+    {
+        int const distance = GetFloodDistance(startCluster, goalTile);
+
+        if (distance != DistanceField::UNREACHABLE) Relax(virtualGoal, distance, virtualStart, distance);
+    }
+
+    bool isFound = false;
+
+    while (!m_openHeap.empty())
+    {
+        OpenEntry const entry = PopOpen();
+
+        if (entry.m_cost != m_nodeCosts[entry.m_node]) continue;    // Superseded by a cheaper push
+
+        if (entry.m_node == virtualGoal)
+        {
+            isFound = true;
+            break;
+        }
+
+        ++m_numExpandedNodes;
+
+        int const      tileX        = entry.m_node % m_dimensions.x;
+        int const      tileY        = entry.m_node / m_dimensions.x;
+        int const      clusterIndex = GetClusterIndex(tileX, tileY);
+        Cluster const& cluster      = m_clusters[clusterIndex];
+        int const      numNodes     = static_cast<int>(cluster.m_nodeTiles.size());
+        int const      nodeIndex    = m_tileNodeIndices[entry.m_node];
+
+        for (int otherIndex = 0; otherIndex < numNodes; ++otherIndex)
+        {
+            uint16_t const distance  = cluster.m_nodeDistances[nodeIndex * numNodes + otherIndex];
+            int const      otherTile = cluster.m_nodeTiles[otherIndex];
+
+            if (otherIndex == nodeIndex || distance == DistanceField::UNREACHABLE) continue;
+
+            Relax(otherTile, entry.m_cost + distance, entry.m_node, entry.m_cost + distance + getHeuristic(otherTile));
+        }
+
+        // Entrance nodes always face open tiles, so any node across a border is one step away
+        auto const visitAcross = [&](int const neighborX, int const neighborY)
+        {
+            int const neighborTile = neighborY * m_dimensions.x + neighborX;
+
+            if (m_tileNodeIndices[neighborTile] < 0 || GetClusterIndex(neighborX, neighborY) == clusterIndex) return;
+
+            Relax(neighborTile, entry.m_cost + 1, entry.m_node, entry.m_cost + 1 + getHeuristic(neighborTile));
+        };
+
+        if (tileX + 1 < m_dimensions.x) visitAcross(tileX + 1, tileY);
+        if (tileY + 1 < m_dimensions.y) visitAcross(tileX, tileY + 1);
+        if (tileY > 0) visitAcross(tileX, tileY - 1);
+        if (tileX > 0) visitAcross(tileX - 1, tileY);
+
+        if (clusterIndex == goalCluster && m_goalNodeDistances[nodeIndex] != DistanceField::UNREACHABLE)
+        {
+            int const cost = entry.m_cost + m_goalNodeDistances[nodeIndex];
+
+            Relax(virtualGoal, cost, entry.m_node, cost);
+        }
+    }
+
+    if (!isFound) return false;
+
+    m_abstractPath.clear();
+
+    for (int node = virtualGoal; node != -1; node = m_nodeParents[node])
+    {
+        m_abstractPath.push_back(node);
+    }
+
+    std::reverse(m_abstractPath.begin(), m_abstractPath.end());
+
+    // Refine: a hop across a border is a single step, any other hop stays inside one cluster
+    int fromTile = startTile;
+
+    out_tilePath.push_back(startCoords);
+
+    for (size_t hopIndex = 1; hopIndex < m_abstractPath.size(); ++hopIndex)
+    {
+        int const toTile        = m_abstractPath[hopIndex] == virtualGoal ? goalTile : m_abstractPath[hopIndex];
+        int const fromCluster = GetClusterIndex(fromTile % m_dimensions.x, fromTile / m_dimensions.x);
+        int const toCluster   = GetClusterIndex(toTile % m_dimensions.x, toTile / m_dimensions.x);
+
+        if (fromCluster != toCluster)
+        {
+            out_tilePath.push_back(IntVec2(toTile % m_dimensions.x, toTile / m_dimensions.x));
+        }
+        else if (fromTile != toTile)
+        {
+            FloodCluster(blockedBits, fromCluster, fromTile);
+            AppendFloodPath(fromCluster, toTile, out_tilePath);
+        }
+
+        fromTile = toTile;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Two in-cluster floods and a component compare, whatever the map size. Both ends must be open, as for FindPath.
+bool TileClusterGraph::AreConnected(TileBitboard const& blockedBits, IntVec2 const& startCoords, IntVec2 const& goalCoords)
+{
+    if (!IsBuilt() || blockedBits.GetDimensions() != m_dimensions) return false;
+    if (startCoords.x < 0 || startCoords.x >= m_dimensions.x || startCoords.y < 0 || startCoords.y >= m_dimensions.y) return false;
+    if (goalCoords.x < 0 || goalCoords.x >= m_dimensions.x || goalCoords.y < 0 || goalCoords.y >= m_dimensions.y) return false;
+    if (blockedBits.IsSet(startCoords) || blockedBits.IsSet(goalCoords)) return false;
+
+    int const startTile    = startCoords.y * m_dimensions.x + startCoords.x;
+    int const goalTile     = goalCoords.y * m_dimensions.x + goalCoords.x;
+    int const startCluster = GetClusterIndex(startCoords.x, startCoords.y);
+    int const goalCluster  = GetClusterIndex(goalCoords.x, goalCoords.y);
+
+    FloodCluster(blockedBits, startCluster, startTile);
+
+    if (startCluster == goalCluster && GetFloodDistance(startCluster, goalTile) != DistanceField::UNREACHABLE) return true;
+
+    Cluster const& startClusterData = m_clusters[startCluster];
+    Cluster const& goalClusterData  = m_clusters[goalCluster];
+
+    m_abstractPath.clear();    // Components reachable from the start
+
+    for (size_t nodeIndex = 0; nodeIndex < startClusterData.m_nodeTiles.size(); ++nodeIndex)
+    {
+        if (GetFloodDistance(startCluster, startClusterData.m_nodeTiles[nodeIndex]) == DistanceField::UNREACHABLE) continue;
+
+        m_abstractPath.push_back(startClusterData.m_nodeComponents[nodeIndex]);
+    }
+
+    FloodCluster(blockedBits, goalCluster, goalTile);
+
+    for (size_t nodeIndex = 0; nodeIndex < goalClusterData.m_nodeTiles.size(); ++nodeIndex)
+    {
+        if (GetFloodDistance(goalCluster, goalClusterData.m_nodeTiles[nodeIndex]) == DistanceField::UNREACHABLE) continue;
+
+        if (std::find(m_abstractPath.begin(), m_abstractPath.end(), goalClusterData.m_nodeComponents[nodeIndex]) != m_abstractPath.end()) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileClusterGraph::GetNumNodes() const
+{
+    int numNodes = 0;
+
+    for (Cluster const& cluster : m_clusters)
+    {
+        numNodes += static_cast<int>(cluster.m_nodeTiles.size());
+    }
+
+    return numNodes;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileClusterGraph::GetClusterIndex(int const tileX, int const tileY) const
+{
+    return (tileY / CLUSTER_SIZE) * m_numClusters.x + tileX / CLUSTER_SIZE;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Entrances on a border only depend on the two tile lines facing each other, so both clusters derive the
+// same ones independently
+void TileClusterGraph::RebuildCluster(TileBitboard const& blockedBits, int const clusterIndex)
+{
+    Cluster& cluster = m_clusters[clusterIndex];
+
+    for (int const nodeTile : cluster.m_nodeTiles)
+    {
+        m_tileNodeIndices[nodeTile] = -1;
+    }
+
+    cluster.m_nodeTiles.clear();
+
+    if (cluster.m_mins.x > 0) AddBorderEntrances(blockedBits, cluster, cluster.m_mins, IntVec2(0, 1), IntVec2(-1, 0));
+    if (cluster.m_maxs.x + 1 < m_dimensions.x) AddBorderEntrances(blockedBits, cluster, IntVec2(cluster.m_maxs.x, cluster.m_mins.y), IntVec2(0, 1), IntVec2(1, 0));
+    if (cluster.m_mins.y > 0) AddBorderEntrances(blockedBits, cluster, cluster.m_mins, IntVec2(1, 0), IntVec2(0, -1));
+    if (cluster.m_maxs.y + 1 < m_dimensions.y) AddBorderEntrances(blockedBits, cluster, IntVec2(cluster.m_mins.x, cluster.m_maxs.y), IntVec2(1, 0), IntVec2(0, 1));
+
+    int const numNodes = static_cast<int>(cluster.m_nodeTiles.size());
+
+    cluster.m_nodeDistances.assign(static_cast<size_t>(numNodes) * static_cast<size_t>(numNodes), DistanceField::UNREACHABLE);
+
+    for (int nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+    {
+        FloodCluster(blockedBits, clusterIndex, cluster.m_nodeTiles[nodeIndex]);
+
+        for (int otherIndex = 0; otherIndex < numNodes; ++otherIndex)
+        {
+            cluster.m_nodeDistances[nodeIndex * numNodes + otherIndex] = static_cast<uint16_t>(GetFloodDistance(clusterIndex, cluster.m_nodeTiles[otherIndex]));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks one border of the cluster from borderStart along step; across points out of the cluster
+void TileClusterGraph::AddBorderEntrances(TileBitboard const& blockedBits,
+                                          Cluster&            cluster,
+                                          IntVec2 const&      borderStart,
+                                          IntVec2 const&      step,
+                                          IntVec2 const&      across)
+{
+    int const borderLength = step.x != 0 ? cluster.m_maxs.x - cluster.m_mins.x + 1 : cluster.m_maxs.y - cluster.m_mins.y + 1;
+    int       runStart     = -1;
+
+    for (int borderIndex = 0; borderIndex <= borderLength; ++borderIndex)
+    {
+        IntVec2 const insideCoords  = GetBorderCoords(borderStart, step, borderIndex);
+        IntVec2 const outsideCoords = insideCoords + across;
+        bool const    isOpen        = borderIndex < borderLength &&
+                                      !blockedBits.IsSet(insideCoords) && !blockedBits.IsSet(outsideCoords);
+
+        if (isOpen)
+        {
+            if (runStart < 0) runStart = borderIndex;
+            continue;
+        }
+
+        if (runStart < 0) continue;
+
+        int const runLength = borderIndex - runStart;
+
+        if (runLength < MIN_TWO_ENTRANCE_RUN)
+        {
+            IntVec2 const entranceCoords = GetBorderCoords(borderStart, step, (runStart + (runLength - 1) / 2));
+            AddNode(cluster, entranceCoords.y * m_dimensions.x + entranceCoords.x);
+        }
+        else
+        {
+            IntVec2 const firstCoords = GetBorderCoords(borderStart, step, runStart);
+            IntVec2 const lastCoords  = GetBorderCoords(borderStart, step, borderIndex - 1);
+            AddNode(cluster, firstCoords.y * m_dimensions.x + firstCoords.x);
+            AddNode(cluster, lastCoords.y * m_dimensions.x + lastCoords.x);
+        }
+
+        runStart = -1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Corner tiles can be an entrance on two borders; they are still one node
+void TileClusterGraph::AddNode(Cluster& cluster, int const tileIndex)
+{
+    if (m_tileNodeIndices[tileIndex] >= 0) return;
+
+    m_tileNodeIndices[tileIndex] = static_cast<int16_t>(cluster.m_nodeTiles.size());
+    cluster.m_nodeTiles.push_back(tileIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Depth-first over the abstract graph; only nodes are visited, so this scales with the node count
+void TileClusterGraph::LabelComponents()
+{
+    for (Cluster& cluster : m_clusters)
+    {
+        cluster.m_nodeComponents.assign(cluster.m_nodeTiles.size(), -1);
+    }
+
+    std::vector<int> pendingTiles;
+    int              numComponents = 0;
+
+    for (Cluster& seedCluster : m_clusters)
+    {
+        for (size_t seedIndex = 0; seedIndex < seedCluster.m_nodeTiles.size(); ++seedIndex)
+        {
+            if (seedCluster.m_nodeComponents[seedIndex] >= 0) continue;
+
+            int const component = numComponents++;
+
+            seedCluster.m_nodeComponents[seedIndex] = component;
+            pendingTiles.push_back(seedCluster.m_nodeTiles[seedIndex]);
+
+            while (!pendingTiles.empty())
+            {
+                int const tileIndex = pendingTiles.back();
+                pendingTiles.pop_back();
+
+                int const      tileX        = tileIndex % m_dimensions.x;
+                int const      tileY        = tileIndex / m_dimensions.x;
+                int const      clusterIndex = GetClusterIndex(tileX, tileY);
+                Cluster&       cluster      = m_clusters[clusterIndex];
+                int const      numNodes     = static_cast<int>(cluster.m_nodeTiles.size());
+                int const      nodeIndex    = m_tileNodeIndices[tileIndex];
+
+                for (int otherIndex = 0; otherIndex < numNodes; ++otherIndex)
+                {
+                    if (cluster.m_nodeComponents[otherIndex] >= 0) continue;
+                    if (cluster.m_nodeDistances[nodeIndex * numNodes + otherIndex] == DistanceField::UNREACHABLE) continue;
+
+                    cluster.m_nodeComponents[otherIndex] = component;
+                    pendingTiles.push_back(cluster.m_nodeTiles[otherIndex]);
+                }
+
+                auto const visitAcross = [&](int const neighborX, int const neighborY)
+                {
+                    int const neighborTile  = neighborY * m_dimensions.x + neighborX;
+                    int const neighborIndex = m_tileNodeIndices[neighborTile];
+
+                    if (neighborIndex < 0) return;
+
+                    Cluster& neighborCluster = m_clusters[GetClusterIndex(neighborX, neighborY)];
+
+                    if (&neighborCluster == &cluster || neighborCluster.m_nodeComponents[neighborIndex] >= 0) return;
+
+                    neighborCluster.m_nodeComponents[neighborIndex] = component;
+                    pendingTiles.push_back(neighborTile);
+                };
+
+                if (tileX + 1 < m_dimensions.x) visitAcross(tileX + 1, tileY);
+                if (tileY + 1 < m_dimensions.y) visitAcross(tileX, tileY + 1);
+                if (tileY > 0) visitAcross(tileX, tileY - 1);
+                if (tileX > 0) visitAcross(tileX - 1, tileY);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// BFS that never leaves the cluster; leaves distances and parents in the flood scratch
+void TileClusterGraph::FloodCluster(TileBitboard const& blockedBits, int const clusterIndex, int const sourceTile)
+{
+    Cluster const& cluster    = m_clusters[clusterIndex];
+    int            readIndex  = 0;
+    int            writeIndex = 0;
+
+    std::fill(m_floodDistances.begin(), m_floodDistances.end(), DistanceField::UNREACHABLE);
+
+    int const sourceLocal = (sourceTile / m_dimensions.x - cluster.m_mins.y) * CLUSTER_SIZE + sourceTile % m_dimensions.x - cluster.m_mins.x;
+
+    m_floodDistances[sourceLocal] = 0;
+    m_floodParents[sourceLocal]   = -1;
+    m_floodQueue[writeIndex++]    = static_cast<int16_t>(sourceLocal);
+
+    while (readIndex < writeIndex)
+    {
+        int const      localIndex   = m_floodQueue[readIndex++];
+        int const      tileX        = cluster.m_mins.x + localIndex % CLUSTER_SIZE;
+        int const      tileY        = cluster.m_mins.y + localIndex / CLUSTER_SIZE;
+        uint16_t const nextDistance = static_cast<uint16_t>(m_floodDistances[localIndex] + 1);
+
+        auto const visit = [&](int const neighborX, int const neighborY)
+        {
+            int const neighborLocal = (neighborY - cluster.m_mins.y) * CLUSTER_SIZE + neighborX - cluster.m_mins.x;
+
+            if (m_floodDistances[neighborLocal] != DistanceField::UNREACHABLE) return;
+            if (blockedBits.IsSet(neighborX, neighborY)) return;
+
+            m_floodDistances[neighborLocal] = nextDistance;
+            m_floodParents[neighborLocal]   = static_cast<int16_t>(localIndex);
+            m_floodQueue[writeIndex++]      = static_cast<int16_t>(neighborLocal);
+        };
+
+        if (tileX < cluster.m_maxs.x) visit(tileX + 1, tileY);
+        if (tileY < cluster.m_maxs.y) visit(tileX, tileY + 1);
+        if (tileY > cluster.m_mins.y) visit(tileX, tileY - 1);
+        if (tileX > cluster.m_mins.x) visit(tileX - 1, tileY);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileClusterGraph::GetFloodDistance(int const clusterIndex, int const tileIndex) const
+{
+    Cluster const& cluster = m_clusters[clusterIndex];
+
+    return m_floodDistances[(tileIndex / m_dimensions.x - cluster.m_mins.y) * CLUSTER_SIZE + tileIndex % m_dimensions.x - cluster.m_mins.x];
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends the last FloodCluster's path to targetTile, leaving out its source tile
+void TileClusterGraph::AppendFloodPath(int const clusterIndex, int const targetTile, std::vector<IntVec2>& out_tilePath) const
+{
+    Cluster const& cluster     = m_clusters[clusterIndex];
+    size_t const   firstAppend = out_tilePath.size();
+
+    for (int localIndex = (targetTile / m_dimensions.x - cluster.m_mins.y) * CLUSTER_SIZE + targetTile % m_dimensions.x - cluster.m_mins.x;
+         m_floodParents[localIndex] != -1;
+         localIndex = m_floodParents[localIndex])
+    {
+        out_tilePath.push_back(IntVec2(cluster.m_mins.x + localIndex % CLUSTER_SIZE, cluster.m_mins.y + localIndex / CLUSTER_SIZE));
+    }
+
+    std::reverse(out_tilePath.begin() + static_cast<std::ptrdiff_t>(firstAppend), out_tilePath.end());
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileClusterGraph::Relax(int const node, int const cost, int const parent, int const estimatedCost)
+{
+    if (m_nodeStamps[node] == m_searchStamp && m_nodeCosts[node] <= cost) return;
+
+    m_nodeStamps[node]  = m_searchStamp;
+    m_nodeCosts[node]   = cost;
+    m_nodeParents[node] = parent;
+    PushOpen({estimatedCost, cost, node});
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileClusterGraph::PushOpen(OpenEntry const& entry)
+{
+    m_openHeap.push_back(entry);
+    std::push_heap(m_openHeap.begin(), m_openHeap.end(), [](OpenEntry const& a, OpenEntry const& b)
+    {
+        return IsWorseOpenEntry(a.m_estimatedCost, a.m_cost, b.m_estimatedCost, b.m_cost);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+TileClusterGraph::OpenEntry TileClusterGraph::PopOpen()
+{
+    std::pop_heap(m_openHeap.begin(), m_openHeap.end(), [](OpenEntry const& a, OpenEntry const& b)
+    {
+        return IsWorseOpenEntry(a.m_estimatedCost, a.m_cost, b.m_estimatedCost, b.m_cost);
+    });
+
+    OpenEntry const entry = m_openHeap.back();
+    m_openHeap.pop_back();
+    return entry;
+}
@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------
+// TileClusterGraph.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class TileBitboard;
+
+//----------------------------------------------------------------------------------------------------
+// HPA*: the map is cut into CLUSTER_SIZE square clusters. Where open tiles face each other across a
+// cluster border, an entrance puts an abstract node on either side; nodes of one cluster are joined by
+// their in-cluster distances, computed once per cluster. A path search only runs over these nodes plus
+// the start and goal clusters, then each abstract hop is refined by a search inside one cluster, so its
+// cost follows the number of clusters crossed rather than the map area.
+//
+// Paths are near-optimal: they are shortest among those that cross borders at entrance tiles. Start and
+// goal must be open tiles.
+//
+class TileClusterGraph
+{
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+
+    void Build(TileBitboard const& blockedBits);
+    void Update(TileBitboard const& blockedBits, IntVec2 const& changedMins, IntVec2 const& changedMaxs);
+    bool IsBuilt() const { return !m_clusters.empty(); }
+
+    bool FindPath(TileBitboard const&   blockedBits,
+                  IntVec2 const&        startCoords,
+                  IntVec2 const&        goalCoords,
+                  std::vector<IntVec2>& out_tilePath);
+    bool AreConnected(TileBitboard const& blockedBits, IntVec2 const& startCoords, IntVec2 const& goalCoords);
+
+    int GetNumNodes() const;
+    int GetNumExpandedNodes() const { return m_numExpandedNodes; }    // Of the last FindPath, for tuning
+
+private:
+    struct Cluster
+    {
+        IntVec2               m_mins;             // Inclusive
+        IntVec2               m_maxs;             // Inclusive
+        std::vector<int>      m_nodeTiles;        // Tile index of each abstract node
+        std::vector<uint16_t> m_nodeDistances;    // numNodes x numNodes in-cluster distances
+        std::vector<int>      m_nodeComponents;   // Connected component of each node over the whole graph
+    };
+
+    struct OpenEntry
+    {
+        int m_estimatedCost = 0;    // Cost so far + Manhattan to the goal
+        int m_cost          = 0;
+        int m_node          = 0;    // Tile index, or one of the virtual start / goal nodes
+    };
+
+    int  GetClusterIndex(int tileX, int tileY) const;
+    void RebuildCluster(TileBitboard const& blockedBits, int clusterIndex);
+    void AddBorderEntrances(TileBitboard const& blockedBits, Cluster& cluster, IntVec2 const& borderStart, IntVec2 const& step, IntVec2 const& across);
+    void AddNode(Cluster& cluster, int tileIndex);
+    void LabelComponents();
+
+    void FloodCluster(TileBitboard const& blockedBits, int clusterIndex, int sourceTile);
+    int  GetFloodDistance(int clusterIndex, int tileIndex) const;
+    void AppendFloodPath(int clusterIndex, int targetTile, std::vector<IntVec2>& out_tilePath) const;
+
+    void Relax(int node, int cost, int parent, int estimatedCost);
+    void PushOpen(OpenEntry const& entry);
+    OpenEntry PopOpen();
+
+    IntVec2               m_dimensions       = IntVec2::ZERO;
+    IntVec2               m_numClusters      = IntVec2::ZERO;
+    std::vector<Cluster>  m_clusters;
+    std::vector<int16_t>  m_tileNodeIndices;    // Per tile, its index in its cluster's m_nodeTiles, or -1
+    int                   m_numExpandedNodes = 0;
+
+    // In-cluster flood scratch, indexed by tile offset within the cluster
+    std::vector<uint16_t> m_floodDistances;
+    std::vector<int16_t>  m_floodParents;
+    std::vector<int16_t>  m_floodQueue;
+
+    // Abstract search scratch; stamped like TilePathfinder so nothing is cleared between searches.
+    // Indexed by tile index, with the virtual start and goal nodes after the last tile.
+    uint32_t               m_searchStamp = 0;
+    std::vector<uint32_t>  m_nodeStamps;
+    std::vector<int>       m_nodeCosts;
+    std::vector<int>       m_nodeParents;
+    std::vector<uint16_t>  m_goalNodeDistances;    // Per node of the goal cluster, for the current search
+    std::vector<OpenEntry> m_openHeap;
+    std::vector<int>       m_abstractPath;
+};
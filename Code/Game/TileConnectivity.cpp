@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------------------------------------
+// TileConnectivity.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileConnectivity.hpp"
+
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void TileConnectivity::Build(TileBitboard const& solidBits, TileBitboard const& waterBits)
+{
+    m_dimensions = solidBits.GetDimensions();
+    m_numRegions = 0;
+    m_regionIds.assign(static_cast<size_t>(m_dimensions.x) * static_cast<size_t>(m_dimensions.y), NO_REGION);
+    m_labelParents.clear();
+
+    // Pass 1: provisional labels from the west and south neighbours, merging where both are open
+    for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+    {
+        uint64_t const* solidRow = solidBits.GetRow(tileY);
+        uint64_t const* waterRow = waterBits.GetRow(tileY);
+        int const       rowStart = tileY * m_dimensions.x;
+
+        for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+        {
+            int const      wordIndex = tileX >> 6;
+            uint64_t const bit       = uint64_t(1) << (tileX & 63);
+
+            if (((solidRow[wordIndex] | waterRow[wordIndex]) & bit) != 0) continue;
+
+            int const westLabel  = tileX > 0 ? m_regionIds[rowStart + tileX - 1] : NO_REGION;
+            int const southLabel = tileY > 0 ? m_regionIds[rowStart - m_dimensions.x + tileX] : NO_REGION;
+            int       label;
+
+            if (westLabel != NO_REGION && southLabel != NO_REGION)
+            {
+                label = westLabel == southLabel ? westLabel : Union(westLabel, southLabel);
+            }
+            else if (westLabel != NO_REGION)
+            {
+                label = westLabel;
+            }
+            else if (southLabel != NO_REGION)
+            {
+                label = southLabel;
+            }
+            else
+            {
+                label = static_cast<int>(m_labelParents.size());
+                m_labelParents.push_back(label);
+            }
+
+            m_regionIds[rowStart + tileX] = label;
+        }
+    }
+
+    // Pass 2: map each provisional label's root to a dense region id (0 .. numRegions - 1)
+    for (int label = 0; label < static_cast<int>(m_labelParents.size()); ++label)
+    {
+        int const root = FindRoot(label);
+
+        if (root == label)
+        {
+            m_labelParents[label] = -1 - m_numRegions;    // Negative marks a root, encoding its region id
+            ++m_numRegions;
+        }
+    }
+
+    for (int& regionId : m_regionIds)
+    {
+        if (regionId == NO_REGION) continue;
+
+        int const root = FindRoot(regionId);
+        regionId       = -1 - m_labelParents[root];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileConnectivity::AreConnected(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB) const
+{
+    int const regionA = GetRegionId(tileCoordsA);
+
+    return regionA != NO_REGION && regionA == GetRegionId(tileCoordsB);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Roots are either self-parented (pass 1) or negative (pass 2); path halving keeps the trees flat
+int TileConnectivity::FindRoot(int label)
+{
+    while (m_labelParents[label] >= 0 && m_labelParents[label] != label)
+    {
+        int const parent = m_labelParents[label];
+
+        if (m_labelParents[parent] >= 0) m_labelParents[label] = m_labelParents[parent];
+
+        label = parent;
+    }
+
+    return label;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The smaller label becomes the root, so roots are always visited before their children in pass 2
+int TileConnectivity::Union(int const labelA, int const labelB)
+{
+    int const rootA = FindRoot(labelA);
+    int const rootB = FindRoot(labelB);
+
+    if (rootA == rootB) return rootA;
+
+    if (rootA < rootB)
+    {
+        m_labelParents[rootB] = rootA;
+        return rootA;
+    }
+
+    m_labelParents[rootA] = rootB;
+    return rootB;
+}
@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------------------------------
+// TileConnectivity.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class TileBitboard;
+
+//----------------------------------------------------------------------------------------------------
+// 4-connected region labels for the open tiles of a map, built in one raster pass with union-find over
+// provisional labels plus one resolve pass. A tile is open when neither its solid nor its water bit is
+// set, the same rule PopulateDistanceField walks by, or when its blocked bit is clear for the
+// single-bitboard Build. Labels are valid for the tiles they were built from;
+// rebuild after the layout changes. Storage is reused between builds, so generation retries do not allocate.
+//
+class TileConnectivity
+{
+public:
+    static constexpr int NO_REGION = -1;
+
+    void Build(TileBitboard const& solidBits, TileBitboard const& waterBits);
+    void Build(TileBitboard const& blockedBits) { Build(blockedBits, blockedBits); }
+
+    int  GetRegionId(int tileX, int tileY) const { return m_regionIds[tileY * m_dimensions.x + tileX]; }
+    int  GetRegionId(IntVec2 const& tileCoords) const { return GetRegionId(tileCoords.x, tileCoords.y); }
+    int  GetNumRegions() const { return m_numRegions; }
+    bool AreConnected(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB) const;
+
+private:
+    int FindRoot(int label);
+    int Union(int labelA, int labelB);
+
+    IntVec2          m_dimensions = IntVec2::ZERO;
+    int              m_numRegions = 0;
+    std::vector<int> m_regionIds;       // Per tile, NO_REGION for blocked tiles
+    std::vector<int> m_labelParents;    // Union-find forest over provisional labels, scratch for Build
+};
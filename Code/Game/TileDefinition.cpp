@@ -6,13 +6,24 @@
 #include "Game/TileDefinition.hpp"
 
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/IntVec2.hpp"
+#include "Game/DefinitionCache.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class SpriteSheet;
 
 //----------------------------------------------------------------------------------------------------
-std::vector<TileDefinition*> TileDefinition::s_tileDefinitions;
+namespace
+{
+    char const* TILE_DEFS_XML_PATH   = "Data/Definitions/TileDefinitions.xml";
+    char const* TILE_DEFS_CACHE_PATH = "Data/Cache/TileDefinitions.bin";
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<TileDefinition*>              TileDefinition::s_tileDefinitions;
+std::vector<unsigned char>                TileDefinition::s_tileFlags;
+std::unordered_map<String, TileTypeIndex> TileDefinition::s_tileTypeIndexByName;
 
 //----------------------------------------------------------------------------------------------------
 TileDefinition::TileDefinition(XmlElement const& tileDefElement, SpriteSheet const& spriteSheet)
@@ -21,57 +32,176 @@ TileDefinition::TileDefinition(XmlElement const& tileDefElement, SpriteSheet con
     m_isSolid                  = ParseXmlAttribute(tileDefElement, "isSolid", false);
     m_isWater                  = ParseXmlAttribute(tileDefElement, "isWater", false);
     IntVec2 const spriteCoords = ParseXmlAttribute(tileDefElement, "spriteCoords", IntVec2(-1, -1));
-    int const     spriteIndex  = spriteCoords.x + spriteCoords.y * 8;
+    m_spriteIndex              = spriteCoords.x + spriteCoords.y * 8;
 
-    if (spriteIndex != -1)
+    if (m_spriteIndex != -1)
     {
-        m_spriteDef = spriteSheet.GetSpriteDef(spriteIndex);
+        m_spriteDef = spriteSheet.GetSpriteDef(m_spriteIndex);
     }
 
     m_tintColor = ParseXmlAttribute(tileDefElement, "tintColor", Rgba8::WHITE);
 }
 
 //----------------------------------------------------------------------------------------------------
-TileDefinition::~TileDefinition()
+// Field order must match WriteToCache
+TileDefinition::TileDefinition(DefinitionCacheReader& reader, SpriteSheet const& spriteSheet)
 {
-    for (TileDefinition const* tileDef : s_tileDefinitions)
+    m_name        = reader.ReadString();
+    m_isSolid     = reader.ReadBool();
+    m_isWater     = reader.ReadBool();
+    m_spriteIndex = reader.ReadInt();
+    m_tintColor   = reader.ReadRgba8();
+
+    if (reader.IsValid() && m_spriteIndex != -1)
     {
-        delete tileDef;
+        m_spriteDef = spriteSheet.GetSpriteDef(m_spriteIndex);
     }
+}
 
-    s_tileDefinitions.clear();
+//----------------------------------------------------------------------------------------------------
+void TileDefinition::WriteToCache(DefinitionCacheWriter& writer) const
+{
+    writer.WriteString(m_name);
+    writer.WriteBool(m_isSolid);
+    writer.WriteBool(m_isWater);
+    writer.WriteInt(m_spriteIndex);
+    writer.WriteRgba8(m_tintColor);
 }
 
 //----------------------------------------------------------------------------------------------------
+// Names are interned once here; everything after load passes TileTypeIndex around instead of names.
+// Safe to call again (e.g. on every new Game); the previous set is released first.
+// Loads from the baked cache when it matches the XML, otherwise parses the XML and re-bakes the cache.
 STATIC void TileDefinition::InitializeTileDefs(SpriteSheet const& spriteSheet)
 {
+    ClearTileDefs();
+
+    uint64_t sourceHash = 0;
+
+    if (!HashFileContents(TILE_DEFS_XML_PATH, sourceHash))
+        return;
+
+    if (LoadTileDefsFromCache(sourceHash, spriteSheet))
+        return;
+
     XmlDocument tileDefXml;
 
-    if (tileDefXml.LoadFile("Data/Definitions/TileDefinitions.xml") != XmlResult::XML_SUCCESS)
+    if (tileDefXml.LoadFile(TILE_DEFS_XML_PATH) != XmlResult::XML_SUCCESS)
         return;
 
     if (XmlElement* root = tileDefXml.FirstChildElement("TileDefinitions"))
     {
         for (XmlElement* element = root->FirstChildElement("TileDefinition"); element != nullptr; element = element->NextSiblingElement("TileDefinition"))
         {
-            TileDefinition* tileDef = new TileDefinition(*element, spriteSheet);
-            s_tileDefinitions.push_back(tileDef);
+            RegisterTileDef(new TileDefinition(*element, spriteSheet));
         }
     }
+
+    SaveTileDefsToCache(sourceHash);
 }
 
 //----------------------------------------------------------------------------------------------------
-STATIC TileDefinition const* TileDefinition::GetTileDefByName(String const& name)
+STATIC bool TileDefinition::LoadTileDefsFromCache(uint64_t const sourceHash, SpriteSheet const& spriteSheet)
 {
-    for (TileDefinition const* tileDef : s_tileDefinitions)
+    DefinitionCacheReader reader;
+
+    if (!reader.LoadFromFile(TILE_DEFS_CACHE_PATH, sourceHash))
+        return false;
+
+    int const numTileDefs = reader.ReadInt();
+
+    for (int tileDefIndex = 0; tileDefIndex < numTileDefs && reader.IsValid(); ++tileDefIndex)
     {
-        if (tileDef->GetName() == name)
+        TileDefinition* tileDef = new TileDefinition(reader, spriteSheet);
+
+        if (!reader.IsValid())
         {
-            return tileDef;
+            delete tileDef;
+            break;
         }
+
+        RegisterTileDef(tileDef);
+    }
+
+    if (reader.IsValid() && reader.IsAtEnd())
+        return true;
+
+    printf("WARNING: definition cache \"%s\" is corrupt, falling back to XML\n", TILE_DEFS_CACHE_PATH);
+    ClearTileDefs();
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TileDefinition::SaveTileDefsToCache(uint64_t const sourceHash)
+{
+    DefinitionCacheWriter writer;
+
+    writer.WriteInt(static_cast<int>(s_tileDefinitions.size()));
+
+    for (TileDefinition const* tileDef : s_tileDefinitions)
+    {
+        tileDef->WriteToCache(writer);
+    }
+
+    writer.SaveToFile(TILE_DEFS_CACHE_PATH, sourceHash);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TileDefinition::RegisterTileDef(TileDefinition* tileDef)
+{
+    GUARANTEE_OR_DIE(s_tileDefinitions.size() <= 255, "Too many tile definitions for TileTypeIndex")
+    GUARANTEE_OR_DIE(s_tileTypeIndexByName.find(tileDef->m_name) == s_tileTypeIndexByName.end(), Stringf("Duplicate tile definition \"%s\"", tileDef->m_name.c_str()))
+
+    s_tileTypeIndexByName[tileDef->m_name] = static_cast<TileTypeIndex>(s_tileDefinitions.size());
+    s_tileDefinitions.push_back(tileDef);
+
+    unsigned char flags = TILE_FLAG_NONE;
+    if (tileDef->IsSolid()) flags |= TILE_FLAG_SOLID;
+    if (tileDef->IsWater()) flags |= TILE_FLAG_WATER;
+    s_tileFlags.push_back(flags);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void TileDefinition::ClearTileDefs()
+{
+    for (TileDefinition const* tileDef : s_tileDefinitions)
+    {
+        delete tileDef;
+    }
+
+    s_tileDefinitions.clear();
+    s_tileFlags.clear();
+    s_tileTypeIndexByName.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC TileDefinition const* TileDefinition::GetTileDefByName(String const& name)
+{
+    auto const found = s_tileTypeIndexByName.find(name);
+
+    if (found == s_tileTypeIndexByName.end()) return nullptr;
+
+    return s_tileDefinitions[found->second];
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC TileDefinition const* TileDefinition::GetTileDefByIndex(TileTypeIndex const tileTypeIndex)
+{
+    return s_tileDefinitions[tileTypeIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC TileTypeIndex TileDefinition::GetTileTypeIndexByName(String const& name)
+{
+    auto const found = s_tileTypeIndexByName.find(name);
+
+    if (found == s_tileTypeIndexByName.end())
+    {
+        ERROR_AND_DIE(Stringf("Unknown tile definition name \"%s\"", name.c_str()))
     }
 
-    return nullptr;
+    return found->second;
 }
 
 //----------------------------------------------------------------------------------------------------
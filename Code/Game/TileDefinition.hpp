@@ -4,6 +4,7 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <unordered_map>
 
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/XmlUtils.hpp"
@@ -11,18 +12,42 @@
 #include "Engine/Renderer/SpriteDefinition.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 
+//----------------------------------------------------------------------------------------------------
+class DefinitionCacheReader;
+class DefinitionCacheWriter;
+
+//----------------------------------------------------------------------------------------------------
+// Index into TileDefinition::s_tileDefinitions, stored per tile instead of the tile name
+typedef unsigned char TileTypeIndex;
+
+//----------------------------------------------------------------------------------------------------
+enum TileFlag : unsigned char
+{
+    TILE_FLAG_NONE  = 0,
+    TILE_FLAG_SOLID = 1 << 0,
+    TILE_FLAG_WATER = 1 << 1
+};
+
 //----------------------------------------------------------------------------------------------------
 struct TileDefinition
 {
     TileDefinition(XmlElement const& tileDefElement, SpriteSheet const& spriteSheet);
-    ~TileDefinition();
+    TileDefinition(DefinitionCacheReader& reader, SpriteSheet const& spriteSheet);
+    ~TileDefinition() = default;
 
-    static void                         InitializeTileDefs(SpriteSheet const& spriteSheet);
-    static TileDefinition const*        GetTileDefByName(String const& name);
-    static StringList                   GetTileNames();
-    static std::vector<TileDefinition*> s_tileDefinitions;
+    void WriteToCache(DefinitionCacheWriter& writer) const;
 
-    String           GetName() const { return m_name; }
+    static void                                      InitializeTileDefs(SpriteSheet const& spriteSheet);
+    static void                                      ClearTileDefs();
+    static TileDefinition const*                     GetTileDefByName(String const& name);
+    static TileDefinition const*                     GetTileDefByIndex(TileTypeIndex tileTypeIndex);
+    static TileTypeIndex                             GetTileTypeIndexByName(String const& name);
+    static StringList                                GetTileNames();
+    static std::vector<TileDefinition*>              s_tileDefinitions;
+    static std::vector<unsigned char>                s_tileFlags;    // TileFlag bits, indexed by TileTypeIndex
+    static std::unordered_map<String, TileTypeIndex> s_tileTypeIndexByName;
+
+    String const&    GetName() const { return m_name; }
     SpriteDefinition GetSpriteDef() const { return m_spriteDef; }
     bool             IsSolid() const { return m_isSolid; }
     bool             IsWater() const { return m_isWater; }
@@ -30,8 +55,13 @@ struct TileDefinition
     AABB2            GetUVs() const { return m_spriteDef.GetUVs(); }
 
 private:
+    static bool LoadTileDefsFromCache(uint64_t sourceHash, SpriteSheet const& spriteSheet);
+    static void SaveTileDefsToCache(uint64_t sourceHash);
+    static void RegisterTileDef(TileDefinition* tileDef);
+
     String           m_name;
     SpriteDefinition m_spriteDef;
+    int              m_spriteIndex = -1;
     bool             m_isSolid = false;
     bool             m_isWater = false;
     Rgba8            m_tintColor;
@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------
+// TileDirtyTracker.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileDirtyTracker.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+// Everything starts dirty, so consumers that have never synced (generation 0) build from scratch
+void TileDirtyTracker::Reset(IntVec2 const& dimensions)
+{
+    m_dimensions = dimensions;
+    m_generation = 0;
+    m_dirtyRects.clear();
+    m_dirtyRects.reserve(MAX_DIRTY_RECTS);
+
+    MarkAllDirty();
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileDirtyTracker::MarkDirty(IntVec2 const& mins, IntVec2 const& maxs)
+{
+    ++m_generation;
+
+    // Extend the newest rect when the change touches it (worm walks, row-by-row writes, ...)
+    if (!m_dirtyRects.empty())
+    {
+        DirtyRect& newest = m_dirtyRects.back();
+
+        if (mins.x <= newest.m_maxs.x + 1 && maxs.x >= newest.m_mins.x - 1 &&
+            mins.y <= newest.m_maxs.y + 1 && maxs.y >= newest.m_mins.y - 1)
+        {
+            newest.m_generation = m_generation;
+            newest.m_mins       = IntVec2(std::min(newest.m_mins.x, mins.x), std::min(newest.m_mins.y, mins.y));
+            newest.m_maxs       = IntVec2(std::max(newest.m_maxs.x, maxs.x), std::max(newest.m_maxs.y, maxs.y));
+            return;
+        }
+    }
+
+    // Out of room: fold the two oldest rects together, keeping the newer generation
+    if (static_cast<int>(m_dirtyRects.size()) == MAX_DIRTY_RECTS)
+    {
+        DirtyRect const& oldest = m_dirtyRects[0];
+        DirtyRect&       next   = m_dirtyRects[1];
+
+        next.m_mins = IntVec2(std::min(oldest.m_mins.x, next.m_mins.x), std::min(oldest.m_mins.y, next.m_mins.y));
+        next.m_maxs = IntVec2(std::max(oldest.m_maxs.x, next.m_maxs.x), std::max(oldest.m_maxs.y, next.m_maxs.y));
+        m_dirtyRects.erase(m_dirtyRects.begin());
+    }
+
+    DirtyRect dirtyRect;
+    dirtyRect.m_generation = m_generation;
+    dirtyRect.m_mins       = mins;
+    dirtyRect.m_maxs       = maxs;
+    m_dirtyRects.push_back(dirtyRect);
+}
+
+//----------------------------------------------------------------------------------------------------
+// A whole-map rect supersedes every older one
+void TileDirtyTracker::MarkAllDirty()
+{
+    m_dirtyRects.clear();
+
+    MarkDirty(IntVec2::ZERO, m_dimensions - IntVec2::ONE);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Union of every rect changed after 'generation'; false if nothing has changed since then
+bool TileDirtyTracker::GetDirtyRectSince(uint32_t const generation, IntVec2& out_mins, IntVec2& out_maxs) const
+{
+    bool isDirty = false;
+
+    for (int rectIndex = static_cast<int>(m_dirtyRects.size()) - 1; rectIndex >= 0; --rectIndex)
+    {
+        DirtyRect const& dirtyRect = m_dirtyRects[rectIndex];
+
+        if (dirtyRect.m_generation <= generation) break;
+
+        if (!isDirty)
+        {
+            out_mins = dirtyRect.m_mins;
+            out_maxs = dirtyRect.m_maxs;
+            isDirty  = true;
+            continue;
+        }
+
+        out_mins = IntVec2(std::min(out_mins.x, dirtyRect.m_mins.x), std::min(out_mins.y, dirtyRect.m_mins.y));
+        out_maxs = IntVec2(std::max(out_maxs.x, dirtyRect.m_maxs.x), std::max(out_maxs.y, dirtyRect.m_maxs.y));
+    }
+
+    return isDirty;
+}
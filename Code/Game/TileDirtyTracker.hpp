@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------------------------------
+// TileDirtyTracker.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Records which tile rectangles changed, stamped with a change generation that increases on every mark.
+// Consumers of derived data (render meshes, heat maps, ...) remember the generation they last synced to
+// and ask for the rect covering everything newer. Rects are merged as they come in, so memory stays
+// bounded; a merged rect may cover a few tiles that did not change, but never misses one that did.
+//
+class TileDirtyTracker
+{
+public:
+    void Reset(IntVec2 const& dimensions);
+    void MarkDirty(IntVec2 const& mins, IntVec2 const& maxs);
+    void MarkDirty(int tileX, int tileY) { MarkDirty(IntVec2(tileX, tileY), IntVec2(tileX, tileY)); }
+    void MarkAllDirty();
+
+    uint32_t GetGeneration() const { return m_generation; }
+    bool     GetDirtyRectSince(uint32_t generation, IntVec2& out_mins, IntVec2& out_maxs) const;
+
+private:
+    struct DirtyRect
+    {
+        uint32_t m_generation = 0;    // Newest change covered by this rect
+        IntVec2  m_mins;              // Inclusive
+        IntVec2  m_maxs;              // Inclusive
+    };
+
+    static constexpr int MAX_DIRTY_RECTS = 32;
+
+    IntVec2                m_dimensions = IntVec2::ZERO;
+    uint32_t               m_generation = 0;
+    std::vector<DirtyRect> m_dirtyRects;    // Oldest first
+};
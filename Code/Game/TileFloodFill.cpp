@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------------------------------
+// TileFloodFill.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileFloodFill.hpp"
+
+#include <algorithm>
+
+#include "Game/DistanceField.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    template <typename Visitor>
+    void ForEachNeighborTile(IntVec2 const& dimensions, int const tileIndex, Visitor const& visit)
+    {
+        int const tileX = tileIndex % dimensions.x;
+        int const tileY = tileIndex / dimensions.x;
+
+        if (tileX + 1 < dimensions.x) visit(tileIndex + 1);
+        if (tileY + 1 < dimensions.y) visit(tileIndex + dimensions.x);
+        if (tileY > 0) visit(tileIndex - dimensions.x);
+        if (tileX > 0) visit(tileIndex - 1);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Distances past DistanceField::MAX_DISTANCE are not representable; no map comes anywhere near that
+void TileFloodFill::Run(DistanceField& field, TileBitboard const& blockedBits, IntVec2 const& startCoords)
+{
+    m_dimensions = blockedBits.GetDimensions();
+
+    if (field.GetDimensions() != m_dimensions) field.Resize(m_dimensions);
+
+    field.FillAll(DistanceField::UNREACHABLE);
+    m_frontier.resize(static_cast<size_t>(m_dimensions.x) * static_cast<size_t>(m_dimensions.y));
+
+    if (startCoords.x < 0 || startCoords.x >= m_dimensions.x ||
+        startCoords.y < 0 || startCoords.y >= m_dimensions.y)
+        return;
+
+    int const startIndex = startCoords.y * m_dimensions.x + startCoords.x;
+    int       readIndex  = 0;
+    int       writeIndex = 0;
+
+    field.SetValue(startIndex, 0);
+    m_frontier[writeIndex++] = startIndex;
+
+    while (readIndex < writeIndex)
+    {
+        int const      tileIndex    = m_frontier[readIndex++];
+        uint16_t const nextDistance = static_cast<uint16_t>(field.GetValue(tileIndex) + 1);
+
+        ForEachNeighborTile(m_dimensions, tileIndex, [&](int const neighborIndex)
+        {
+            if (field.GetValue(neighborIndex) != DistanceField::UNREACHABLE) return;
+            if (blockedBits.IsSet(neighborIndex % m_dimensions.x, neighborIndex / m_dimensions.x)) return;
+
+            field.SetValue(neighborIndex, nextDistance);
+            m_frontier[writeIndex++] = neighborIndex;
+        });
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// field must hold the distances from oldStartCoords over the blocked bits as they were before, and only
+// tiles inside the inclusive changed rect may have changed passability since. This is the unit-cost
+// dynamic BFS: tiles that lose every shortest-path parent are invalidated, then regrown from their
+// still-valid boundary. A moved start is handled as "add the new source, then drop the old one", so
+// only tiles that end up closer to the new start, or farther from the old one, are touched.
+void TileFloodFill::Repair(DistanceField&      field,
+                           TileBitboard const& blockedBits,
+                           IntVec2 const&      oldStartCoords,
+                           IntVec2 const&      newStartCoords,
+                           IntVec2 const&      changedMins,
+                           IntVec2 const&      changedMaxs)
+{
+    m_dimensions        = blockedBits.GetDimensions();
+    m_repairField       = &field;
+    m_repairBlockedBits = &blockedBits;
+
+    if (m_invalidBits.GetDimensions() != m_dimensions) m_invalidBits.Resize(m_dimensions);
+
+    int const oldStartIndex = oldStartCoords.y * m_dimensions.x + oldStartCoords.x;
+    int const newStartIndex = newStartCoords.y * m_dimensions.x + newStartCoords.x;
+    int const minX          = std::max(changedMins.x, 0);
+    int const minY          = std::max(changedMins.y, 0);
+    int const maxX          = std::min(changedMaxs.x, m_dimensions.x - 1);
+    int const maxY          = std::min(changedMaxs.y, m_dimensions.y - 1);
+
+    // 1. Both starts are sources while the changed tiles are repaired; newly blocked tiles lose their value
+    m_sourceIndices[0] = oldStartIndex;
+    m_sourceIndices[1] = newStartIndex;
+    m_numSources       = 2;
+    m_invalidBits.ClearAll();
+    m_invalidTiles.clear();
+
+    for (int tileY = minY; tileY <= maxY; ++tileY)
+    {
+        for (int tileX = minX; tileX <= maxX; ++tileX)
+        {
+            int const tileIndex = tileY * m_dimensions.x + tileX;
+
+            if (IsSource(tileIndex) || !blockedBits.IsSet(tileX, tileY)) continue;
+            if (field.GetValue(tileIndex) == DistanceField::UNREACHABLE) continue;
+
+            m_invalidBits.Set(tileX, tileY);
+            m_invalidTiles.push_back(tileIndex);
+        }
+    }
+
+    InvalidateUnsupportedTiles();
+
+    // 2. Regrow from the invalidated tiles, the newly opened tiles and the new start
+    m_repairSeeds.clear();
+
+    for (int const tileIndex : m_invalidTiles)
+    {
+        AddRepairSeed(tileIndex);
+    }
+
+    for (int tileY = minY; tileY <= maxY; ++tileY)
+    {
+        for (int tileX = minX; tileX <= maxX; ++tileX)
+        {
+            AddRepairSeed(tileY * m_dimensions.x + tileX);
+        }
+    }
+
+    AddRepairSeed(newStartIndex);
+    PropagateRepairSeeds();
+
+    // 3. Drop the old start; tiles only it supported regrow from the new start's side
+    if (oldStartIndex != newStartIndex)
+    {
+        m_sourceIndices[0] = newStartIndex;
+        m_numSources       = 1;
+        m_invalidBits.ClearAll();
+        m_invalidTiles.clear();
+        m_invalidBits.Set(oldStartCoords.x, oldStartCoords.y);
+        m_invalidTiles.push_back(oldStartIndex);
+
+        InvalidateUnsupportedTiles();
+
+        m_repairSeeds.clear();
+
+        for (int const tileIndex : m_invalidTiles)
+        {
+            AddRepairSeed(tileIndex);
+        }
+
+        PropagateRepairSeeds();
+    }
+
+    m_repairField       = nullptr;
+    m_repairBlockedBits = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileFloodFill::IsSource(int const tileIndex) const
+{
+    for (int sourceIndex = 0; sourceIndex < m_numSources; ++sourceIndex)
+    {
+        if (m_sourceIndices[sourceIndex] == tileIndex) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileFloodFill::IsEnterable(int const tileIndex) const
+{
+    return !m_repairBlockedBits->IsSet(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Grows m_invalidTiles to every tile left without a valid neighbor one step closer to a source, then
+// clears their values. Old values are kept until the end so parent tests still see the old field.
+void TileFloodFill::InvalidateUnsupportedTiles()
+{
+    DistanceField& field = *m_repairField;
+
+    for (size_t invalidIndex = 0; invalidIndex < m_invalidTiles.size(); ++invalidIndex)
+    {
+        int const tileIndex     = m_invalidTiles[invalidIndex];
+        int const childDistance = field.GetValue(tileIndex) + 1;
+
+        ForEachNeighborTile(m_dimensions, tileIndex, [&](int const childIndex)
+        {
+            int const childX = childIndex % m_dimensions.x;
+            int const childY = childIndex / m_dimensions.x;
+
+            if (m_invalidBits.IsSet(childX, childY) || IsSource(childIndex)) return;
+            if (field.GetValue(childIndex) != childDistance) return;
+
+            bool hasValidParent = false;
+
+            ForEachNeighborTile(m_dimensions, childIndex, [&](int const parentIndex)
+            {
+                if (hasValidParent) return;
+                if (m_invalidBits.IsSet(parentIndex % m_dimensions.x, parentIndex / m_dimensions.x)) return;
+                if (!IsEnterable(parentIndex) && !IsSource(parentIndex)) return;
+
+                hasValidParent = field.GetValue(parentIndex) + 1 == childDistance;
+            });
+
+            if (hasValidParent) return;
+
+            m_invalidBits.Set(childX, childY);
+            m_invalidTiles.push_back(childIndex);
+        });
+    }
+
+    for (int const tileIndex : m_invalidTiles)
+    {
+        field.SetValue(tileIndex, DistanceField::UNREACHABLE);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Lowers a tile to what its current neighbors (or being a source) allow, and queues it if that helped
+void TileFloodFill::AddRepairSeed(int const tileIndex)
+{
+    DistanceField& field    = *m_repairField;
+    bool const     isSource = IsSource(tileIndex);
+
+    if (!isSource && !IsEnterable(tileIndex)) return;
+
+    uint16_t bestDistance = isSource ? 0 : DistanceField::UNREACHABLE;
+
+    if (!isSource)
+    {
+        ForEachNeighborTile(m_dimensions, tileIndex, [&](int const neighborIndex)
+        {
+            if (!IsEnterable(neighborIndex) && !IsSource(neighborIndex)) return;
+
+            uint16_t const neighborDistance = field.GetValue(neighborIndex);
+
+            if (neighborDistance < bestDistance - 1) bestDistance = static_cast<uint16_t>(neighborDistance + 1);
+        });
+    }
+
+    if (bestDistance >= field.GetValue(tileIndex)) return;
+
+    field.SetValue(tileIndex, bestDistance);
+    m_repairSeeds.push_back({tileIndex, bestDistance});
+}
+
+//----------------------------------------------------------------------------------------------------
+// Seeds come sorted and the FIFO only ever holds non-decreasing distances, so popping the smaller head
+// of the two visits tiles in distance order, like Run does from a single start
+void TileFloodFill::PropagateRepairSeeds()
+{
+    DistanceField& field = *m_repairField;
+
+    std::sort(m_repairSeeds.begin(), m_repairSeeds.end(), [](RepairEntry const& a, RepairEntry const& b)
+    {
+        return a.m_distance < b.m_distance;
+    });
+
+    m_repairFrontier.clear();
+
+    size_t seedIndex     = 0;
+    size_t frontierIndex = 0;
+
+    while (seedIndex < m_repairSeeds.size() || frontierIndex < m_repairFrontier.size())
+    {
+        bool const takeSeed = frontierIndex == m_repairFrontier.size() ||
+                              (seedIndex < m_repairSeeds.size() && m_repairSeeds[seedIndex].m_distance <= m_repairFrontier[frontierIndex].m_distance);
+
+        RepairEntry const entry = takeSeed ? m_repairSeeds[seedIndex++] : m_repairFrontier[frontierIndex++];
+
+        if (field.GetValue(entry.m_tileIndex) != entry.m_distance) continue;    // Lowered again after it was queued
+
+        uint16_t const nextDistance = static_cast<uint16_t>(entry.m_distance + 1);
+
+        ForEachNeighborTile(m_dimensions, entry.m_tileIndex, [&](int const neighborIndex)
+        {
+            if (!IsEnterable(neighborIndex)) return;
+            if (nextDistance >= field.GetValue(neighborIndex)) return;
+
+            field.SetValue(neighborIndex, nextDistance);
+            m_repairFrontier.push_back({neighborIndex, nextDistance});
+        });
+    }
+}
@@ -0,0 +1,61 @@
+//----------------------------------------------------------------------------------------------------
+// TileFloodFill.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class DistanceField;
+
+//----------------------------------------------------------------------------------------------------
+// Breadth-first distance field over 4-connected tiles. Run uses a frontier queue so every tile is
+// visited at most once. Passability comes in as a "blocked" bitboard, so the same engine serves land,
+// amphibian and Scorpio-avoiding fields. The start tile is always reached, even if it is blocked,
+// matching the old scan-based fields. Storage is reused between runs.
+//
+// Repair updates an existing field in place after the start moves or some tiles change passability.
+// Its cost is proportional to the tiles whose distance actually changes.
+//
+class TileFloodFill
+{
+public:
+    void Run(DistanceField& field, TileBitboard const& blockedBits, IntVec2 const& startCoords);
+    void Repair(DistanceField&      field,
+                TileBitboard const& blockedBits,
+                IntVec2 const&      oldStartCoords,
+                IntVec2 const&      newStartCoords,
+                IntVec2 const&      changedMins,
+                IntVec2 const&      changedMaxs);
+
+private:
+    struct RepairEntry
+    {
+        int      m_tileIndex = 0;
+        uint16_t m_distance  = 0;
+    };
+
+    bool IsSource(int tileIndex) const;
+    bool IsEnterable(int tileIndex) const;
+    void InvalidateUnsupportedTiles();
+    void AddRepairSeed(int tileIndex);
+    void PropagateRepairSeeds();
+
+    IntVec2          m_dimensions = IntVec2::ZERO;
+    std::vector<int> m_frontier;    // Tile indices in visit order; each tile is pushed once, so W * H never overflows
+
+    // Repair state, only valid during a Repair call
+    DistanceField*           m_repairField       = nullptr;
+    TileBitboard const*      m_repairBlockedBits = nullptr;
+    int                      m_sourceIndices[2]  = {};
+    int                      m_numSources        = 0;
+    TileBitboard             m_invalidBits;
+    std::vector<int>         m_invalidTiles;
+    std::vector<RepairEntry> m_repairSeeds;
+    std::vector<RepairEntry> m_repairFrontier;
+};
@@ -0,0 +1,400 @@
+//----------------------------------------------------------------------------------------------------
+// TilePathfinder.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TilePathfinder.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Lower f first; on ties the deeper node, which heads straight for the goal instead of widening the front
+    bool IsWorseOpenEntry(int const estimatedCostA, int const costA, int const estimatedCostB, int const costB)
+    {
+        if (estimatedCostA != estimatedCostB) return estimatedCostA > estimatedCostB;
+
+        return costA < costB;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Farthest-point selection: the first landmark is the tile farthest from seedCoords, each next one the
+// tile farthest from all landmarks so far. Tiles seedCoords cannot reach are never picked.
+void TilePathfinder::BuildLandmarks(TileBitboard const& blockedBits, IntVec2 const& seedCoords, int const numLandmarks)
+{
+    m_dimensions = blockedBits.GetDimensions();
+    m_landmarkFields.clear();
+
+    int const     numTiles = m_dimensions.x * m_dimensions.y;
+    DistanceField seedField;
+    std::vector<uint16_t> nearestLandmarkDistances;
+
+    m_floodFill.Run(seedField, blockedBits, seedCoords);
+    nearestLandmarkDistances.assign(seedField.GetData(), seedField.GetData() + numTiles);
+
+    for (int landmarkIndex = 0; landmarkIndex < numLandmarks; ++landmarkIndex)
+    {
+        int      farthestIndex    = -1;
+        uint16_t farthestDistance = 0;
+
+        for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+        {
+            uint16_t const distance = nearestLandmarkDistances[tileIndex];
+
+            if (distance != DistanceField::UNREACHABLE && distance > farthestDistance)
+            {
+                farthestIndex    = tileIndex;
+                farthestDistance = distance;
+            }
+        }
+
+        if (farthestIndex == -1) break;    // Every reachable tile already is a landmark
+
+        m_landmarkFields.emplace_back();
+
+        DistanceField& landmarkField = m_landmarkFields.back();
+        m_floodFill.Run(landmarkField, blockedBits, IntVec2(farthestIndex % m_dimensions.x, farthestIndex / m_dimensions.x));
+
+        for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+        {
+            nearestLandmarkDistances[tileIndex] = std::min(nearestLandmarkDistances[tileIndex], landmarkField.GetValue(tileIndex));
+        }
+    }
+
+    m_goalLandmarkDistances.resize(m_landmarkFields.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Fills out_tilePath with the tiles from start to goal, both included. Returns false, leaving it empty,
+// if the goal cannot be reached.
+bool TilePathfinder::FindPath(TileBitboard const&   blockedBits,
+                              IntVec2 const&        startCoords,
+                              IntVec2 const&        goalCoords,
+                              PathHeuristic const   heuristic,
+                              std::vector<IntVec2>& out_tilePath)
+{
+    out_tilePath.clear();
+
+    if (!BeginSearch(blockedBits, startCoords, goalCoords)) return false;
+
+    int const startIndex = startCoords.y * m_dimensions.x + startCoords.x;
+    int const goalIndex  = m_goalIndex;
+
+    for (size_t landmarkIndex = 0; landmarkIndex < m_landmarkFields.size(); ++landmarkIndex)
+    {
+        m_goalLandmarkDistances[landmarkIndex] = m_landmarkFields[landmarkIndex].GetValue(goalIndex);
+    }
+
+    m_openHeap.clear();
+    m_tileStamps[startIndex]  = m_searchStamp;
+    m_tileCosts[startIndex]   = 0;
+    m_tileParents[startIndex] = -1;
+    PushOpen({GetHeuristic(startIndex, heuristic), 0, startIndex});
+
+    while (!m_openHeap.empty())
+    {
+        OpenEntry const entry = PopOpen();
+
+        if (entry.m_cost != m_tileCosts[entry.m_tileIndex]) continue;    // Superseded by a cheaper push
+
+        if (entry.m_tileIndex == goalIndex)
+        {
+            for (int tileIndex = goalIndex; tileIndex != -1; tileIndex = m_tileParents[tileIndex])
+            {
+                out_tilePath.push_back(IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x));
+            }
+
+            std::reverse(out_tilePath.begin(), out_tilePath.end());
+            return true;
+        }
+
+        ++m_numExpandedTiles;
+
+        int const tileX        = entry.m_tileIndex % m_dimensions.x;
+        int const tileY        = entry.m_tileIndex / m_dimensions.x;
+        int const neighborCost = entry.m_cost + 1;
+
+        auto const visit = [&](int const neighborX, int const neighborY)
+        {
+            int const neighborIndex = neighborY * m_dimensions.x + neighborX;
+
+            if (neighborIndex != goalIndex && blockedBits.IsSet(neighborX, neighborY)) return;
+            if (m_tileStamps[neighborIndex] == m_searchStamp && m_tileCosts[neighborIndex] <= neighborCost) return;
+
+            m_tileStamps[neighborIndex]  = m_searchStamp;
+            m_tileCosts[neighborIndex]   = neighborCost;
+            m_tileParents[neighborIndex] = entry.m_tileIndex;
+            PushOpen({neighborCost + GetHeuristic(neighborIndex, heuristic), neighborCost, neighborIndex});
+        };
+
+        if (tileX + 1 < m_dimensions.x) visit(tileX + 1, tileY);
+        if (tileY + 1 < m_dimensions.y) visit(tileX, tileY + 1);
+        if (tileY > 0) visit(tileX, tileY - 1);
+        if (tileX > 0) visit(tileX - 1, tileY);
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 8-connected Jump Point Search. Straight steps cost JPS_STRAIGHT_COST and diagonal ones JPS_DIAGONAL_COST;
+// a diagonal step needs both tiles it cuts past to be open, the same corners PushEntityOutOfSolidTiles
+// would push a mover off. Only the tiles where the path turns or could turn are expanded and returned:
+// out_jumpPoints runs start to goal, both included, and consecutive points lie on one straight or
+// diagonal line. Returns false, leaving it empty, if the goal cannot be reached.
+bool TilePathfinder::FindJumpPointPath(TileBitboard const&   blockedBits,
+                                       IntVec2 const&        startCoords,
+                                       IntVec2 const&        goalCoords,
+                                       std::vector<IntVec2>& out_jumpPoints)
+{
+    out_jumpPoints.clear();
+
+    if (!BeginSearch(blockedBits, startCoords, goalCoords)) return false;
+
+    int const startIndex = startCoords.y * m_dimensions.x + startCoords.x;
+
+    m_openHeap.clear();
+    m_tileStamps[startIndex]  = m_searchStamp;
+    m_tileCosts[startIndex]   = 0;
+    m_tileParents[startIndex] = -1;
+    PushOpen({GetOctileDistance(startCoords, goalCoords), 0, startIndex});
+
+    while (!m_openHeap.empty())
+    {
+        OpenEntry const entry = PopOpen();
+
+        if (entry.m_cost != m_tileCosts[entry.m_tileIndex]) continue;    // Superseded by a cheaper push
+
+        if (entry.m_tileIndex == m_goalIndex)
+        {
+            for (int tileIndex = m_goalIndex; tileIndex != -1; tileIndex = m_tileParents[tileIndex])
+            {
+                out_jumpPoints.push_back(IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x));
+            }
+
+            std::reverse(out_jumpPoints.begin(), out_jumpPoints.end());
+            return true;
+        }
+
+        ++m_numExpandedTiles;
+
+        IntVec2 const tileCoords(entry.m_tileIndex % m_dimensions.x, entry.m_tileIndex / m_dimensions.x);
+
+        auto const visit = [&](int const stepX, int const stepY)
+        {
+            int const jumpIndex = Jump(blockedBits, tileCoords, stepX, stepY);
+
+            if (jumpIndex == -1) return;
+
+            IntVec2 const jumpCoords(jumpIndex % m_dimensions.x, jumpIndex / m_dimensions.x);
+            int const     jumpCost = entry.m_cost + GetOctileDistance(tileCoords, jumpCoords);
+
+            if (m_tileStamps[jumpIndex] == m_searchStamp && m_tileCosts[jumpIndex] <= jumpCost) return;
+
+            m_tileStamps[jumpIndex]  = m_searchStamp;
+            m_tileCosts[jumpIndex]   = jumpCost;
+            m_tileParents[jumpIndex] = entry.m_tileIndex;
+            PushOpen({jumpCost + GetOctileDistance(jumpCoords, goalCoords), jumpCost, jumpIndex});
+        };
+
+        int const parentIndex = m_tileParents[entry.m_tileIndex];
+
+        if (parentIndex == -1)
+        {
+            for (int stepY = -1; stepY <= 1; ++stepY)
+            {
+                for (int stepX = -1; stepX <= 1; ++stepX)
+                {
+                    if (stepX != 0 || stepY != 0) visit(stepX, stepY);
+                }
+            }
+
+            continue;
+        }
+
+        // Pruned neighbors: keep heading the same way, plus the turns an obstacle may have forced.
+        // Jump rejects any step into a blocked tile or past a blocked corner.
+        int const tileX  = tileCoords.x;
+        int const tileY  = tileCoords.y;
+        int const deltaX = tileX - parentIndex % m_dimensions.x;
+        int const deltaY = tileY - parentIndex / m_dimensions.x;
+        int const stepX  = (deltaX > 0) - (deltaX < 0);
+        int const stepY  = (deltaY > 0) - (deltaY < 0);
+
+        if (stepX != 0 && stepY != 0)
+        {
+            visit(stepX, 0);
+            visit(0, stepY);
+            visit(stepX, stepY);
+        }
+        else if (stepX != 0)
+        {
+            visit(stepX, 0);
+            visit(stepX, 1);
+            visit(stepX, -1);
+            visit(0, 1);
+            visit(0, -1);
+        }
+        else
+        {
+            visit(0, stepY);
+            visit(1, stepY);
+            visit(-1, stepY);
+            visit(1, 0);
+            visit(-1, 0);
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Resets the per-search state; false if either end is off the map
+bool TilePathfinder::BeginSearch(TileBitboard const& blockedBits, IntVec2 const& startCoords, IntVec2 const& goalCoords)
+{
+    m_numExpandedTiles = 0;
+
+    if (blockedBits.GetDimensions() != m_dimensions)
+    {
+        m_dimensions = blockedBits.GetDimensions();
+        m_landmarkFields.clear();
+    }
+
+    int const numTiles = m_dimensions.x * m_dimensions.y;
+
+    if (static_cast<int>(m_tileStamps.size()) != numTiles)
+    {
+        m_tileStamps.assign(numTiles, 0);
+        m_tileCosts.resize(numTiles);
+        m_tileParents.resize(numTiles);
+        m_searchStamp = 0;
+    }
+
+    if (startCoords.x < 0 || startCoords.x >= m_dimensions.x || startCoords.y < 0 || startCoords.y >= m_dimensions.y) return false;
+    if (goalCoords.x < 0 || goalCoords.x >= m_dimensions.x || goalCoords.y < 0 || goalCoords.y >= m_dimensions.y) return false;
+
+    // Wrapping the stamp would make stale tiles look current
+    if (++m_searchStamp == 0)
+    {
+        std::fill(m_tileStamps.begin(), m_tileStamps.end(), 0);
+        m_searchStamp = 1;
+    }
+
+    m_goalCoords = goalCoords;
+    m_goalIndex  = goalCoords.y * m_dimensions.x + goalCoords.x;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The goal counts as open even when blocked, so a path can always end on it
+bool TilePathfinder::IsOpen(TileBitboard const& blockedBits, int const tileX, int const tileY) const
+{
+    if (tileX < 0 || tileX >= m_dimensions.x || tileY < 0 || tileY >= m_dimensions.y) return false;
+
+    return tileY * m_dimensions.x + tileX == m_goalIndex || !blockedBits.IsSet(tileX, tileY);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks from tileCoords one step at a time until a jump point (the goal, or a tile with a forced
+// neighbor) and returns its index, or -1 on hitting a wall. A diagonal walk stops wherever one of its
+// two straight components would find a jump point.
+int TilePathfinder::Jump(TileBitboard const& blockedBits, IntVec2 const& tileCoords, int const stepX, int const stepY) const
+{
+    int tileX = tileCoords.x;
+    int tileY = tileCoords.y;
+
+    while (true)
+    {
+        if (stepX != 0 && stepY != 0 &&
+            (!IsOpen(blockedBits, tileX + stepX, tileY) || !IsOpen(blockedBits, tileX, tileY + stepY)))
+            return -1;
+
+        tileX += stepX;
+        tileY += stepY;
+
+        if (!IsOpen(blockedBits, tileX, tileY)) return -1;
+
+        int const tileIndex = tileY * m_dimensions.x + tileX;
+
+        if (tileIndex == m_goalIndex) return tileIndex;
+
+        if (stepX != 0 && stepY != 0)
+        {
+            if (Jump(blockedBits, IntVec2(tileX, tileY), stepX, 0) != -1) return tileIndex;
+            if (Jump(blockedBits, IntVec2(tileX, tileY), 0, stepY) != -1) return tileIndex;
+        }
+        else if (stepX != 0)
+        {
+            // A wall beside the previous tile ends here: the open side could not be reached sooner
+            if (IsOpen(blockedBits, tileX, tileY + 1) && !IsOpen(blockedBits, tileX - stepX, tileY + 1)) return tileIndex;
+            if (IsOpen(blockedBits, tileX, tileY - 1) && !IsOpen(blockedBits, tileX - stepX, tileY - 1)) return tileIndex;
+        }
+        else
+        {
+            if (IsOpen(blockedBits, tileX + 1, tileY) && !IsOpen(blockedBits, tileX + 1, tileY - stepY)) return tileIndex;
+            if (IsOpen(blockedBits, tileX - 1, tileY) && !IsOpen(blockedBits, tileX - 1, tileY - stepY)) return tileIndex;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int TilePathfinder::GetOctileDistance(IntVec2 const& coordsA, IntVec2 const& coordsB)
+{
+    int const deltaX = std::abs(coordsA.x - coordsB.x);
+    int const deltaY = std::abs(coordsA.y - coordsB.y);
+
+    return JPS_DIAGONAL_COST * std::min(deltaX, deltaY) + JPS_STRAIGHT_COST * (std::max(deltaX, deltaY) - std::min(deltaX, deltaY));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Both bounds are admissible, so the larger one is too. A landmark that cannot reach the tile or the
+// goal says nothing about their distance and is skipped.
+int TilePathfinder::GetHeuristic(int const tileIndex, PathHeuristic const heuristic) const
+{
+    int const tileX = tileIndex % m_dimensions.x;
+    int const tileY = tileIndex / m_dimensions.x;
+    int       bound = std::abs(tileX - m_goalCoords.x) + std::abs(tileY - m_goalCoords.y);
+
+    if (heuristic != PATH_HEURISTIC_LANDMARKS) return bound;
+
+    for (size_t landmarkIndex = 0; landmarkIndex < m_landmarkFields.size(); ++landmarkIndex)
+    {
+        uint16_t const tileDistance = m_landmarkFields[landmarkIndex].GetValue(tileIndex);
+        uint16_t const goalDistance = m_goalLandmarkDistances[landmarkIndex];
+
+        if (tileDistance == DistanceField::UNREACHABLE || goalDistance == DistanceField::UNREACHABLE) continue;
+
+        bound = std::max(bound, std::abs(static_cast<int>(tileDistance) - static_cast<int>(goalDistance)));
+    }
+
+    return bound;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TilePathfinder::PushOpen(OpenEntry const& entry)
+{
+    m_openHeap.push_back(entry);
+    std::push_heap(m_openHeap.begin(), m_openHeap.end(), [](OpenEntry const& a, OpenEntry const& b)
+    {
+        return IsWorseOpenEntry(a.m_estimatedCost, a.m_cost, b.m_estimatedCost, b.m_cost);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+TilePathfinder::OpenEntry TilePathfinder::PopOpen()
+{
+    std::pop_heap(m_openHeap.begin(), m_openHeap.end(), [](OpenEntry const& a, OpenEntry const& b)
+    {
+        return IsWorseOpenEntry(a.m_estimatedCost, a.m_cost, b.m_estimatedCost, b.m_cost);
+    });
+
+    OpenEntry const entry = m_openHeap.back();
+    m_openHeap.pop_back();
+    return entry;
+}
@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------------------------------
+// TilePathfinder.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/DistanceField.hpp"
+#include "Game/TileFloodFill.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class TileBitboard;
+
+//----------------------------------------------------------------------------------------------------
+enum PathHeuristic : int
+{
+    PATH_HEURISTIC_MANHATTAN,    // |dx| + |dy|
+    PATH_HEURISTIC_LANDMARKS,    // ALT: triangle-inequality bound from precomputed landmark distances, never below Manhattan
+    NUM_PATH_HEURISTICS
+};
+
+//----------------------------------------------------------------------------------------------------
+// Point-to-point A* over 4-connected tiles, for when one path is needed rather than a whole distance
+// field. Passability comes in as a blocked bitboard, as for TileFloodFill; the start tile is always
+// expanded and the goal tile can always be entered. FindJumpPointPath is the 8-connected alternative
+// that returns only the turning points.
+//
+// Landmark tables are full distance fields from a few far-apart tiles. They stay admissible for any
+// blocked bits that block at least what they were built from, so build them over the most permissive
+// terrain and rebuild after tiles open up.
+//
+class TilePathfinder
+{
+public:
+    void BuildLandmarks(TileBitboard const& blockedBits, IntVec2 const& seedCoords, int numLandmarks);
+    void ClearLandmarks() { m_landmarkFields.clear(); }
+    int  GetNumLandmarks() const { return static_cast<int>(m_landmarkFields.size()); }
+
+    bool FindPath(TileBitboard const&   blockedBits,
+                  IntVec2 const&        startCoords,
+                  IntVec2 const&        goalCoords,
+                  PathHeuristic         heuristic,
+                  std::vector<IntVec2>& out_tilePath);
+
+    bool FindJumpPointPath(TileBitboard const&   blockedBits,
+                           IntVec2 const&        startCoords,
+                           IntVec2 const&        goalCoords,
+                           std::vector<IntVec2>& out_jumpPoints);
+
+    int GetNumExpandedTiles() const { return m_numExpandedTiles; }    // Of the last search, for tuning
+
+    // Jump Point Search step costs, in tenths of a tile
+    static constexpr int JPS_STRAIGHT_COST = 10;
+    static constexpr int JPS_DIAGONAL_COST = 14;
+
+private:
+    struct OpenEntry
+    {
+        int m_estimatedCost = 0;    // Cost so far + heuristic
+        int m_cost          = 0;
+        int m_tileIndex     = 0;
+    };
+
+    bool BeginSearch(TileBitboard const& blockedBits, IntVec2 const& startCoords, IntVec2 const& goalCoords);
+    int  GetHeuristic(int tileIndex, PathHeuristic heuristic) const;
+    bool IsOpen(TileBitboard const& blockedBits, int tileX, int tileY) const;
+    int  Jump(TileBitboard const& blockedBits, IntVec2 const& tileCoords, int stepX, int stepY) const;
+
+    static int GetOctileDistance(IntVec2 const& coordsA, IntVec2 const& coordsB);
+    void PushOpen(OpenEntry const& entry);
+    OpenEntry PopOpen();
+
+    IntVec2                    m_dimensions       = IntVec2::ZERO;
+    std::vector<DistanceField> m_landmarkFields;
+    std::vector<uint16_t>      m_goalLandmarkDistances;    // Per landmark, for the current search
+    IntVec2                    m_goalCoords       = IntVec2::ZERO;
+    int                        m_goalIndex        = -1;
+    int                        m_numExpandedTiles = 0;
+
+    // Search scratch; a tile's cost and parent are only valid when its stamp matches m_searchStamp,
+    // so nothing is cleared between searches
+    uint32_t               m_searchStamp = 0;
+    std::vector<uint32_t>  m_tileStamps;
+    std::vector<int>       m_tileCosts;
+    std::vector<int>       m_tileParents;
+    std::vector<OpenEntry> m_openHeap;
+    TileFloodFill          m_floodFill;    // Landmark building only
+};
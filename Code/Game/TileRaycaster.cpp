@@ -0,0 +1,467 @@
+//----------------------------------------------------------------------------------------------------
+// TileRaycaster.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileRaycaster.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <emmintrin.h>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    float constexpr NEVER = FLT_MAX;    // Ray length to the next boundary along an axis the ray doesn't move on
+
+    //----------------------------------------------------------------------------------------------------
+    struct RayTraversal
+    {
+        IntVec2 m_tileCoords;
+        int     m_stepX  = 0;
+        int     m_stepY  = 0;
+        float   m_tPerX  = NEVER;    // Ray length per whole tile along each axis
+        float   m_tPerY  = NEVER;
+        float   m_tNextX = NEVER;    // Ray length to the next boundary crossed along each axis
+        float   m_tNextY = NEVER;
+    };
+
+    //----------------------------------------------------------------------------------------------------
+    RayTraversal BeginTraversal(Ray2 const& ray)
+    {
+        Vec2 const&  startPos  = ray.m_startPosition;
+        Vec2 const&  fwdNormal = ray.m_forwardNormal;
+        RayTraversal traversal;
+
+        traversal.m_tileCoords = IntVec2(RoundDownToInt(startPos.x), RoundDownToInt(startPos.y));
+        traversal.m_stepX      = fwdNormal.x < 0.f ? -1 : 1;
+        traversal.m_stepY      = fwdNormal.y < 0.f ? -1 : 1;
+
+        if (fwdNormal.x != 0.f)
+        {
+            float const distToBoundaryX = traversal.m_stepX > 0 ? static_cast<float>(traversal.m_tileCoords.x + 1) - startPos.x : startPos.x - static_cast<float>(traversal.m_tileCoords.x);
+
+            traversal.m_tPerX  = 1.f / fabsf(fwdNormal.x);
+            traversal.m_tNextX = distToBoundaryX * traversal.m_tPerX;
+        }
+
+        if (fwdNormal.y != 0.f)
+        {
+            float const distToBoundaryY = traversal.m_stepY > 0 ? static_cast<float>(traversal.m_tileCoords.y + 1) - startPos.y : startPos.y - static_cast<float>(traversal.m_tileCoords.y);
+
+            traversal.m_tPerY  = 1.f / fabsf(fwdNormal.y);
+            traversal.m_tNextY = distToBoundaryY * traversal.m_tPerY;
+        }
+
+        return traversal;
+    }
+
+    //----------------------------------------------------------------------------------------------------
+    bool IsTileBlocked(TileBitboard const& blockedBits, int const tileX, int const tileY)
+    {
+        IntVec2 const dimensions = blockedBits.GetDimensions();
+
+        if (static_cast<unsigned>(tileX) >= static_cast<unsigned>(dimensions.x)) return true;
+        if (static_cast<unsigned>(tileY) >= static_cast<unsigned>(dimensions.y)) return true;
+
+        return blockedBits.IsSet(tileX, tileY);
+    }
+
+    //----------------------------------------------------------------------------------------------------
+    RaycastResult2D MakeMissResult(Ray2 const& ray)
+    {
+        RaycastResult2D raycastResult;
+        raycastResult.m_rayForwardNormal = ray.m_forwardNormal;
+        raycastResult.m_rayStartPosition = ray.m_startPosition;
+        raycastResult.m_rayMaxLength     = ray.m_maxLength;
+        raycastResult.m_didImpact        = false;
+
+        return raycastResult;
+    }
+
+    //----------------------------------------------------------------------------------------------------
+    void SetImpact(RaycastResult2D& raycastResult, Ray2 const& ray, float const impactLength, Vec2 const& impactNormal)
+    {
+        raycastResult.m_didImpact      = true;
+        raycastResult.m_impactLength   = impactLength;
+        raycastResult.m_impactPosition = ray.m_startPosition + ray.m_forwardNormal * impactLength;
+        raycastResult.m_impactNormal   = impactNormal;
+    }
+
+    //----------------------------------------------------------------------------------------------------
+    // Lowers bestLength to where a disc of discRadius, moving along the ray, first touches the tile, and
+    // returns whether it did. A disc that already overlaps the tile only counts (at length 0) if it is moving
+    // further in, so a disc resting against a wall it just bounced off is free to leave.
+    bool SweepDiscVsTile(Ray2 const& ray, float const discRadius, int const tileX, int const tileY, float& bestLength, Vec2& bestNormal)
+    {
+        Vec2 const& startPos  = ray.m_startPosition;
+        Vec2 const& fwdNormal = ray.m_forwardNormal;
+        Vec2 const  mins      = Vec2(static_cast<float>(tileX), static_cast<float>(tileY));
+        Vec2 const  maxs      = mins + Vec2(1.f, 1.f);
+        Vec2 const  closest   = Vec2(GetClamped(startPos.x, mins.x, maxs.x), GetClamped(startPos.y, mins.y, maxs.y));
+        Vec2 const  offset    = startPos - closest;
+        float const distSq    = offset.GetLengthSquared();
+
+        if (distSq < discRadius * discRadius)
+        {
+            Vec2 normal = offset;
+
+            // Center inside the tile: out through the nearest face
+            if (distSq == 0.f)
+            {
+                float const penetrations[4] = {startPos.x - mins.x, maxs.x - startPos.x, startPos.y - mins.y, maxs.y - startPos.y};
+                Vec2 const  faceNormals[4]  = {Vec2(-1.f, 0.f), Vec2(1.f, 0.f), Vec2(0.f, -1.f), Vec2(0.f, 1.f)};
+                int         nearestFace     = 0;
+
+                for (int face = 1; face < 4; ++face)
+                {
+                    if (penetrations[face] < penetrations[nearestFace]) nearestFace = face;
+                }
+
+                normal = faceNormals[nearestFace];
+            }
+
+            if (DotProduct2D(normal, fwdNormal) < 0.f)
+            {
+                bestLength = 0.f;
+                bestNormal = normal.GetNormalized();
+                return true;
+            }
+
+            return false;
+        }
+
+        if (fwdNormal.x == 0.f && fwdNormal.y == 0.f) return false;
+
+        // Slab test against the tile grown by the radius; its corners are rounded, handled below
+        float enterLength = -NEVER;
+        float exitLength  = NEVER;
+        Vec2  faceNormal;
+
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            float const start = axis == 0 ? startPos.x : startPos.y;
+            float const fwd   = axis == 0 ? fwdNormal.x : fwdNormal.y;
+            float const lower = (axis == 0 ? mins.x : mins.y) - discRadius;
+            float const upper = (axis == 0 ? maxs.x : maxs.y) + discRadius;
+
+            if (fwd == 0.f)
+            {
+                if (start < lower || start > upper) return false;
+                continue;
+            }
+
+            float const lowerLength = (lower - start) / fwd;
+            float const upperLength = (upper - start) / fwd;
+            float const nearLength  = fwd > 0.f ? lowerLength : upperLength;
+            float const farLength   = fwd > 0.f ? upperLength : lowerLength;
+
+            if (nearLength > enterLength)
+            {
+                enterLength = nearLength;
+                faceNormal  = axis == 0 ? Vec2(fwd > 0.f ? -1.f : 1.f, 0.f) : Vec2(0.f, fwd > 0.f ? -1.f : 1.f);
+            }
+
+            exitLength = std::min(exitLength, farLength);
+        }
+
+        if (enterLength > exitLength || enterLength > bestLength) return false;
+
+        Vec2 const enterPos = startPos + fwdNormal * enterLength;
+        bool const isPastX  = enterPos.x < mins.x || enterPos.x > maxs.x;
+        bool const isPastY  = enterPos.y < mins.y || enterPos.y > maxs.y;
+
+        if (!isPastX || !isPastY)
+        {
+            if (enterLength < 0.f) return false;
+
+            bestLength = enterLength;
+            bestNormal = faceNormal;
+            return true;
+        }
+
+        // Entered through a grown corner: the disc meets the tile's corner point instead
+        Vec2 const  corner       = Vec2(enterPos.x < mins.x ? mins.x : maxs.x, enterPos.y < mins.y ? mins.y : maxs.y);
+        Vec2 const  toStart      = startPos - corner;
+        float const halfB        = DotProduct2D(toStart, fwdNormal);
+        float const c            = toStart.GetLengthSquared() - discRadius * discRadius;
+        float const discriminant = halfB * halfB - c;
+
+        if (halfB >= 0.f || discriminant < 0.f) return false;
+
+        float const impactLength = -halfB - sqrtf(discriminant);
+
+        if (impactLength > bestLength) return false;
+
+        bestLength = impactLength;
+        bestNormal = (startPos + fwdNormal * impactLength - corner).GetNormalized();
+        return true;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The impact is the exact entry point of the first blocking tile, with that face's normal; a ray
+// starting inside one impacts at its start, facing back along the ray.
+STATIC RaycastResult2D TileRaycaster::Raycast(TileBitboard const& blockedBits, Ray2 const& ray)
+{
+    RaycastResult2D raycastResult = MakeMissResult(ray);
+    RayTraversal    traversal     = BeginTraversal(ray);
+
+    if (IsTileBlocked(blockedBits, traversal.m_tileCoords.x, traversal.m_tileCoords.y))
+    {
+        SetImpact(raycastResult, ray, 0.f, -ray.m_forwardNormal);
+        return raycastResult;
+    }
+
+    while (true)
+    {
+        float   impactLength;
+        IntVec2 impactNormal;
+
+        if (traversal.m_tNextX < traversal.m_tNextY)
+        {
+            impactLength = traversal.m_tNextX;
+            impactNormal = IntVec2(-traversal.m_stepX, 0);
+            traversal.m_tileCoords.x += traversal.m_stepX;
+            traversal.m_tNextX += traversal.m_tPerX;
+        }
+        else
+        {
+            impactLength = traversal.m_tNextY;
+            impactNormal = IntVec2(0, -traversal.m_stepY);
+            traversal.m_tileCoords.y += traversal.m_stepY;
+            traversal.m_tNextY += traversal.m_tPerY;
+        }
+
+        if (impactLength > ray.m_maxLength) break;
+
+        if (IsTileBlocked(blockedBits, traversal.m_tileCoords.x, traversal.m_tileCoords.y))
+        {
+            SetImpact(raycastResult, ray, impactLength, Vec2(impactNormal));
+            break;
+        }
+    }
+
+    return raycastResult;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same results as Raycast, ray for ray. Each lane traces one ray; as soon as a lane's ray hits or runs
+// past its max length the lane takes the next unstarted ray, so one long ray doesn't idle the others.
+// Lanes also track the bitboard word of their tile, so the per-lane test is a single load.
+STATIC void TileRaycaster::RaycastBatch(TileBitboard const& blockedBits, Ray2 const* rays, int const numRays, RaycastResult2D* out_results)
+{
+    IntVec2 const dimensions = blockedBits.GetDimensions();
+
+    if (dimensions.x <= 0 || dimensions.y <= 0)
+    {
+        for (int rayIndex = 0; rayIndex < numRays; ++rayIndex)
+        {
+            out_results[rayIndex] = Raycast(blockedBits, rays[rayIndex]);
+        }
+
+        return;
+    }
+
+    int constexpr   ALL_LANES   = (1 << NUM_BATCH_LANES) - 1;
+    uint64_t const* words       = blockedBits.GetRow(0);
+    int const       wordsPerRow = blockedBits.GetWordsPerRow();
+
+    alignas(16) int   laneTileX[NUM_BATCH_LANES]     = {};
+    alignas(16) int   laneTileY[NUM_BATCH_LANES]     = {};
+    alignas(16) int   laneRowWord[NUM_BATCH_LANES]   = {};    // Index of the first word of the lane's row
+    alignas(16) int   laneStepX[NUM_BATCH_LANES]     = {};    // Only written on refill, so always current
+    alignas(16) int   laneStepY[NUM_BATCH_LANES]     = {};
+    alignas(16) int   laneRowStep[NUM_BATCH_LANES]   = {};    // laneStepY in words
+    alignas(16) float laneTPerX[NUM_BATCH_LANES]     = {};
+    alignas(16) float laneTPerY[NUM_BATCH_LANES]     = {};
+    alignas(16) float laneTNextX[NUM_BATCH_LANES]    = {};
+    alignas(16) float laneTNextY[NUM_BATCH_LANES]    = {};
+    alignas(16) float laneMaxLength[NUM_BATCH_LANES] = {};
+    alignas(16) float laneLengths[NUM_BATCH_LANES];
+    alignas(16) int   laneWordIndices[NUM_BATCH_LANES];
+    alignas(16) int   laneBitIndices[NUM_BATCH_LANES];
+    int               laneRayIndices[NUM_BATCH_LANES] = {};
+    int               activeLanes                     = 0;    // One bit per lane with a ray in flight
+    int               nextRay                         = 0;
+
+    __m128i const zero      = _mm_setzero_si128();
+    __m128i const lastTileX = _mm_set1_epi32(dimensions.x - 1);
+    __m128i const lastTileY = _mm_set1_epi32(dimensions.y - 1);
+    __m128i const bitMask   = _mm_set1_epi32(63);
+
+    __m128i tileX     = zero;
+    __m128i tileY     = zero;
+    __m128i rowWord   = zero;
+    __m128i stepX     = zero;
+    __m128i stepY     = zero;
+    __m128i rowStep   = zero;
+    __m128  tPerX     = _mm_setzero_ps();
+    __m128  tPerY     = _mm_setzero_ps();
+    __m128  tNextX    = _mm_setzero_ps();
+    __m128  tNextY    = _mm_setzero_ps();
+    __m128  maxLength = _mm_setzero_ps();
+
+    while (true)
+    {
+        // Refill idle lanes; rays that start inside a blocking tile are answered here and never get one
+        if (activeLanes != ALL_LANES && nextRay < numRays)
+        {
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneTileX), tileX);
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneTileY), tileY);
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneRowWord), rowWord);
+            _mm_store_ps(laneTNextX, tNextX);
+            _mm_store_ps(laneTNextY, tNextY);
+
+            for (int lane = 0; lane < NUM_BATCH_LANES && nextRay < numRays; ++lane)
+            {
+                if ((activeLanes & (1 << lane)) != 0) continue;
+
+                while (nextRay < numRays)
+                {
+                    int const          rayIndex  = nextRay++;
+                    Ray2 const&        ray       = rays[rayIndex];
+                    RayTraversal const traversal = BeginTraversal(ray);
+
+                    out_results[rayIndex] = MakeMissResult(ray);
+
+                    if (IsTileBlocked(blockedBits, traversal.m_tileCoords.x, traversal.m_tileCoords.y))
+                    {
+                        SetImpact(out_results[rayIndex], ray, 0.f, -ray.m_forwardNormal);
+                        continue;
+                    }
+
+                    laneRayIndices[lane] = rayIndex;
+                    laneTileX[lane]      = traversal.m_tileCoords.x;
+                    laneTileY[lane]      = traversal.m_tileCoords.y;
+                    laneRowWord[lane]    = traversal.m_tileCoords.y * wordsPerRow;
+                    laneStepX[lane]      = traversal.m_stepX;
+                    laneStepY[lane]      = traversal.m_stepY;
+                    laneRowStep[lane]    = traversal.m_stepY * wordsPerRow;
+                    laneTPerX[lane]      = traversal.m_tPerX;
+                    laneTPerY[lane]      = traversal.m_tPerY;
+                    laneTNextX[lane]     = traversal.m_tNextX;
+                    laneTNextY[lane]     = traversal.m_tNextY;
+                    laneMaxLength[lane]  = ray.m_maxLength;
+                    activeLanes |= 1 << lane;
+                    break;
+                }
+            }
+
+            tileX     = _mm_load_si128(reinterpret_cast<__m128i const*>(laneTileX));
+            tileY     = _mm_load_si128(reinterpret_cast<__m128i const*>(laneTileY));
+            rowWord   = _mm_load_si128(reinterpret_cast<__m128i const*>(laneRowWord));
+            stepX     = _mm_load_si128(reinterpret_cast<__m128i const*>(laneStepX));
+            stepY     = _mm_load_si128(reinterpret_cast<__m128i const*>(laneStepY));
+            rowStep   = _mm_load_si128(reinterpret_cast<__m128i const*>(laneRowStep));
+            tPerX     = _mm_load_ps(laneTPerX);
+            tPerY     = _mm_load_ps(laneTPerY);
+            tNextX    = _mm_load_ps(laneTNextX);
+            tNextY    = _mm_load_ps(laneTNextY);
+            maxLength = _mm_load_ps(laneMaxLength);
+        }
+
+        if (activeLanes == 0) break;
+
+        // Every lane crosses whichever of its two next boundaries is nearer; idle lanes step along harmlessly
+        __m128 const  isStepX     = _mm_cmplt_ps(tNextX, tNextY);
+        __m128i const isStepXBits = _mm_castps_si128(isStepX);
+        __m128 const  lengths     = _mm_or_ps(_mm_and_ps(isStepX, tNextX), _mm_andnot_ps(isStepX, tNextY));
+
+        tileX   = _mm_add_epi32(tileX, _mm_and_si128(isStepXBits, stepX));
+        tileY   = _mm_add_epi32(tileY, _mm_andnot_si128(isStepXBits, stepY));
+        rowWord = _mm_add_epi32(rowWord, _mm_andnot_si128(isStepXBits, rowStep));
+        tNextX  = _mm_add_ps(tNextX, _mm_and_ps(isStepX, tPerX));
+        tNextY  = _mm_add_ps(tNextY, _mm_andnot_ps(isStepX, tPerY));
+
+        activeLanes &= ~_mm_movemask_ps(_mm_cmpgt_ps(lengths, maxLength));
+
+        if (activeLanes == 0) continue;
+
+        // Lanes off the map read word 0 instead, then count as blocked regardless
+        __m128i const isOutsideX = _mm_or_si128(_mm_cmplt_epi32(tileX, zero), _mm_cmpgt_epi32(tileX, lastTileX));
+        __m128i const isOutsideY = _mm_or_si128(_mm_cmplt_epi32(tileY, zero), _mm_cmpgt_epi32(tileY, lastTileY));
+        __m128i const isOutside  = _mm_or_si128(isOutsideX, isOutsideY);
+        int           hitLanes   = _mm_movemask_ps(_mm_castsi128_ps(isOutside));
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneWordIndices), _mm_andnot_si128(isOutside, _mm_add_epi32(rowWord, _mm_srai_epi32(tileX, 6))));
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneBitIndices), _mm_and_si128(tileX, bitMask));
+
+        for (int lane = 0; lane < NUM_BATCH_LANES; ++lane)
+        {
+            hitLanes |= static_cast<int>((words[laneWordIndices[lane]] >> laneBitIndices[lane]) & 1) << lane;
+        }
+
+        hitLanes &= activeLanes;
+
+        if (hitLanes == 0) continue;
+
+        int const stepXLanes = _mm_movemask_ps(isStepX);
+
+        _mm_store_ps(laneLengths, lengths);
+
+        for (int lane = 0; lane < NUM_BATCH_LANES; ++lane)
+        {
+            int const laneBit = 1 << lane;
+
+            if ((hitLanes & laneBit) == 0) continue;
+
+            IntVec2 const impactNormal = (stepXLanes & laneBit) != 0 ? IntVec2(-laneStepX[lane], 0) : IntVec2(0, -laneStepY[lane]);
+
+            SetImpact(out_results[laneRayIndices[lane]], rays[laneRayIndices[lane]], laneLengths[lane], Vec2(impactNormal));
+            activeLanes &= ~laneBit;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The impact is where the disc's center is when it first touches a blocking tile, with the contact normal
+// (a face normal, or out of a corner). The center walks the usual traversal; every tile the disc can
+// touch while the center is in a tile lies within floor(radius) + 1 of it, and a contact at some length is
+// found by the time the center reaches it, so the walk stops once it passes the best contact so far.
+STATIC RaycastResult2D TileRaycaster::SweepDisc(TileBitboard const& blockedBits, Ray2 const& ray, float const discRadius)
+{
+    RaycastResult2D raycastResult = MakeMissResult(ray);
+    RayTraversal    traversal     = BeginTraversal(ray);
+    int const       reach         = RoundDownToInt(discRadius) + 1;
+    float           tileLength    = 0.f;    // Ray length at which the center entered the current tile
+    float           bestLength    = ray.m_maxLength;
+    Vec2            bestNormal;
+    bool            didImpact     = false;
+
+    while (tileLength <= bestLength)
+    {
+        for (int tileY = traversal.m_tileCoords.y - reach; tileY <= traversal.m_tileCoords.y + reach; ++tileY)
+        {
+            for (int tileX = traversal.m_tileCoords.x - reach; tileX <= traversal.m_tileCoords.x + reach; ++tileX)
+            {
+                if (!IsTileBlocked(blockedBits, tileX, tileY)) continue;
+
+                if (SweepDiscVsTile(ray, discRadius, tileX, tileY, bestLength, bestNormal)) didImpact = true;
+            }
+        }
+
+        if (traversal.m_tNextX < traversal.m_tNextY)
+        {
+            tileLength = traversal.m_tNextX;
+            traversal.m_tileCoords.x += traversal.m_stepX;
+            traversal.m_tNextX += traversal.m_tPerX;
+        }
+        else
+        {
+            tileLength = traversal.m_tNextY;
+            traversal.m_tileCoords.y += traversal.m_stepY;
+            traversal.m_tNextY += traversal.m_tPerY;
+        }
+    }
+
+    if (didImpact) SetImpact(raycastResult, ray, bestLength, bestNormal);
+
+    return raycastResult;
+}
@@ -0,0 +1,26 @@
+//----------------------------------------------------------------------------------------------------
+// TileRaycaster.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/RaycastUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class TileBitboard;
+
+//----------------------------------------------------------------------------------------------------
+// Amanatides-Woo grid traversal against a bitboard of tiles that stop rays; the map edge stops them too.
+// RaycastBatch runs the same traversal four rays at a time in SSE2 lanes (structure of arrays): the
+// boundary stepping is vectorized, only the bit test for the tile each lane just entered is per lane.
+// SweepDisc walks the same traversal with a disc around the ray, for continuous collision.
+//
+class TileRaycaster
+{
+public:
+    static RaycastResult2D Raycast(TileBitboard const& blockedBits, Ray2 const& ray);
+    static void            RaycastBatch(TileBitboard const& blockedBits, Ray2 const* rays, int numRays, RaycastResult2D* out_results);
+    static RaycastResult2D SweepDisc(TileBitboard const& blockedBits, Ray2 const& ray, float discRadius);
+
+    static constexpr int NUM_BATCH_LANES = 4;
+};
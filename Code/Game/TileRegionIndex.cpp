@@ -0,0 +1,269 @@
+//----------------------------------------------------------------------------------------------------
+// TileRegionIndex.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileRegionIndex.hpp"
+
+#include <algorithm>
+
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void TileRegionIndex::Build(TileBitboard const& blockedBits)
+{
+    m_connectivity.Build(blockedBits);
+
+    m_dimensions = blockedBits.GetDimensions();
+
+    int const numTiles = m_dimensions.x * m_dimensions.y;
+
+    m_regionIds.assign(numTiles, NO_REGION);
+    m_tileSlots.assign(numTiles, 0);
+    m_regionTiles.assign(m_connectivity.GetNumRegions(), std::vector<int>());
+    m_freeRegionIds.clear();
+    m_visitStamps.assign(numTiles, 0);
+    m_visitFloods.assign(numTiles, 0);
+    m_visitStamp = 0;
+
+    for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+    {
+        int const regionId = m_connectivity.GetRegionId(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+
+        if (regionId != NO_REGION) AddTileToRegion(tileIndex, regionId);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileRegionIndex::SetTileBlocked(int const tileX, int const tileY, bool const isBlocked)
+{
+    int const tileIndex  = tileY * m_dimensions.x + tileX;
+    int const regionId   = m_regionIds[tileIndex];
+    bool const wasBlocked = regionId == NO_REGION;
+
+    if (wasBlocked == isBlocked) return;
+
+    if (!isBlocked)
+    {
+        MergeRegionsAround(tileIndex);
+        return;
+    }
+
+    RemoveTileFromRegion(tileIndex);
+
+    if (m_regionTiles[regionId].empty())
+    {
+        m_freeRegionIds.push_back(regionId);
+        return;
+    }
+
+    SplitRegionAround(tileIndex, regionId);
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 TileRegionIndex::GetRegionTile(int const regionId, int const tileSlot) const
+{
+    int const tileIndex = m_regionTiles[regionId][tileSlot];
+
+    return IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileRegionIndex::AllocateRegion()
+{
+    if (!m_freeRegionIds.empty())
+    {
+        int const regionId = m_freeRegionIds.back();
+        m_freeRegionIds.pop_back();
+        return regionId;
+    }
+
+    m_regionTiles.emplace_back();
+    return static_cast<int>(m_regionTiles.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileRegionIndex::AddTileToRegion(int const tileIndex, int const regionId)
+{
+    std::vector<int>& regionTiles = m_regionTiles[regionId];
+
+    m_regionIds[tileIndex] = regionId;
+    m_tileSlots[tileIndex] = static_cast<int>(regionTiles.size());
+    regionTiles.push_back(tileIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Swap-remove: the region's last tile takes over the freed slot
+void TileRegionIndex::RemoveTileFromRegion(int const tileIndex)
+{
+    std::vector<int>& regionTiles = m_regionTiles[m_regionIds[tileIndex]];
+    int const         tileSlot    = m_tileSlots[tileIndex];
+    int const         lastTile    = regionTiles.back();
+
+    regionTiles[tileSlot]  = lastTile;
+    m_tileSlots[lastTile]  = tileSlot;
+    regionTiles.pop_back();
+    m_regionIds[tileIndex] = NO_REGION;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The newly opened tile joins the largest neighboring region; the others are relabelled into it
+void TileRegionIndex::MergeRegionsAround(int const tileIndex)
+{
+    int neighborRegionIds[4];
+    int numNeighborRegions = 0;
+    int largestRegionId    = NO_REGION;
+
+    ForEachNeighborTile(tileIndex, [&](int const neighborIndex)
+    {
+        int const regionId = m_regionIds[neighborIndex];
+
+        if (regionId == NO_REGION) return;
+        if (std::find(neighborRegionIds, neighborRegionIds + numNeighborRegions, regionId) != neighborRegionIds + numNeighborRegions) return;
+
+        neighborRegionIds[numNeighborRegions++] = regionId;
+
+        if (largestRegionId == NO_REGION || GetRegionSize(regionId) > GetRegionSize(largestRegionId)) largestRegionId = regionId;
+    });
+
+    if (largestRegionId == NO_REGION) largestRegionId = AllocateRegion();
+
+    for (int neighborIndex = 0; neighborIndex < numNeighborRegions; ++neighborIndex)
+    {
+        int const regionId = neighborRegionIds[neighborIndex];
+
+        if (regionId == largestRegionId) continue;
+
+        for (int const movedTile : m_regionTiles[regionId])
+        {
+            AddTileToRegion(movedTile, largestRegionId);
+        }
+
+        m_regionTiles[regionId].clear();
+        m_freeRegionIds.push_back(regionId);
+    }
+
+    AddTileToRegion(tileIndex, largestRegionId);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Floods from every open neighbor of the just-closed tile take turns one tile at a time. Floods that
+// meet are unioned into one set; a set whose floods all run dry before meeting the rest is a whole
+// component on its own and moves to a new region. Stops as soon as one live set is left, which keeps
+// regionId, so only the smaller pieces are ever walked in full.
+void TileRegionIndex::SplitRegionAround(int const tileIndex, int const regionId)
+{
+    int numFloods = 0;
+
+    if (++m_visitStamp == 0)
+    {
+        std::fill(m_visitStamps.begin(), m_visitStamps.end(), 0);
+        m_visitStamp = 1;
+    }
+
+    ForEachNeighborTile(tileIndex, [&](int const neighborIndex)
+    {
+        if (m_regionIds[neighborIndex] != regionId) return;
+
+        m_visitStamps[neighborIndex] = m_visitStamp;
+        m_visitFloods[neighborIndex] = static_cast<uint8_t>(numFloods);
+        m_floodTiles[numFloods].clear();
+        m_floodTiles[numFloods].push_back(neighborIndex);
+        ++numFloods;
+    });
+
+    if (numFloods < 2) return;    // Closing a dead end never splits anything
+
+    int  floodSets[MAX_SPLIT_FLOODS];
+    int  readIndices[MAX_SPLIT_FLOODS];
+    bool isSplitOff[MAX_SPLIT_FLOODS];
+    int  numLiveSets = numFloods;
+
+    for (int floodIndex = 0; floodIndex < numFloods; ++floodIndex)
+    {
+        floodSets[floodIndex]   = floodIndex;
+        readIndices[floodIndex] = 0;
+        isSplitOff[floodIndex]  = false;
+    }
+
+    auto const findSet = [&](int floodIndex)
+    {
+        while (floodSets[floodIndex] != floodIndex) floodIndex = floodSets[floodIndex];
+        return floodIndex;
+    };
+
+    while (numLiveSets > 1)
+    {
+        for (int floodIndex = 0; floodIndex < numFloods; ++floodIndex)
+        {
+            if (isSplitOff[findSet(floodIndex)]) continue;
+            if (readIndices[floodIndex] == static_cast<int>(m_floodTiles[floodIndex].size())) continue;
+
+            int const currentTile = m_floodTiles[floodIndex][readIndices[floodIndex]++];
+
+            ForEachNeighborTile(currentTile, [&](int const neighborIndex)
+            {
+                if (m_regionIds[neighborIndex] != regionId) return;
+
+                if (m_visitStamps[neighborIndex] != m_visitStamp)
+                {
+                    m_visitStamps[neighborIndex] = m_visitStamp;
+                    m_visitFloods[neighborIndex] = static_cast<uint8_t>(floodIndex);
+                    m_floodTiles[floodIndex].push_back(neighborIndex);
+                    return;
+                }
+
+                int const setA = findSet(floodIndex);
+                int const setB = findSet(m_visitFloods[neighborIndex]);
+
+                if (setA == setB) return;
+
+                floodSets[std::max(setA, setB)] = std::min(setA, setB);
+                --numLiveSets;
+            });
+        }
+
+        for (int setIndex = 0; setIndex < numFloods && numLiveSets > 1; ++setIndex)
+        {
+            if (floodSets[setIndex] != setIndex || isSplitOff[setIndex]) continue;
+
+            bool isDry = true;
+
+            for (int floodIndex = 0; floodIndex < numFloods; ++floodIndex)
+            {
+                if (findSet(floodIndex) == setIndex && readIndices[floodIndex] < static_cast<int>(m_floodTiles[floodIndex].size())) isDry = false;
+            }
+
+            if (!isDry) continue;
+
+            int const splitRegionId = AllocateRegion();
+
+            for (int floodIndex = 0; floodIndex < numFloods; ++floodIndex)
+            {
+                if (findSet(floodIndex) != setIndex) continue;
+
+                for (int const movedTile : m_floodTiles[floodIndex])
+                {
+                    RemoveTileFromRegion(movedTile);
+                    AddTileToRegion(movedTile, splitRegionId);
+                }
+            }
+
+            isSplitOff[setIndex] = true;
+            --numLiveSets;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename Visitor>
+void TileRegionIndex::ForEachNeighborTile(int const tileIndex, Visitor const& visit) const
+{
+    int const tileX = tileIndex % m_dimensions.x;
+    int const tileY = tileIndex / m_dimensions.x;
+
+    if (tileX + 1 < m_dimensions.x) visit(tileIndex + 1);
+    if (tileY + 1 < m_dimensions.y) visit(tileIndex + m_dimensions.x);
+    if (tileY > 0) visit(tileIndex - m_dimensions.x);
+    if (tileX > 0) visit(tileIndex - 1);
+}
@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------------------------------
+// TileRegionIndex.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/TileConnectivity.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class TileBitboard;
+
+//----------------------------------------------------------------------------------------------------
+// The open tiles of each 4-connected region, kept in one flat list per region so a uniform pick from a
+// region is a single index. Built once with TileConnectivity, then kept current one tile at a time:
+// opening a tile joins its neighbors' regions (the smaller lists move into the largest), closing one
+// races a flood from each open neighbor and splits off whichever side runs out first, so the work
+// follows the smaller piece rather than the map.
+//
+class TileRegionIndex
+{
+public:
+    static constexpr int NO_REGION = TileConnectivity::NO_REGION;
+
+    void Build(TileBitboard const& blockedBits);
+    void SetTileBlocked(int tileX, int tileY, bool isBlocked);
+    bool IsBuilt() const { return !m_regionIds.empty(); }
+
+    int     GetRegionId(IntVec2 const& tileCoords) const { return m_regionIds[tileCoords.y * m_dimensions.x + tileCoords.x]; }
+    int     GetRegionSize(int regionId) const { return static_cast<int>(m_regionTiles[regionId].size()); }
+    IntVec2 GetRegionTile(int regionId, int tileSlot) const;
+
+private:
+    int  AllocateRegion();
+    void AddTileToRegion(int tileIndex, int regionId);
+    void RemoveTileFromRegion(int tileIndex);
+    void MergeRegionsAround(int tileIndex);
+    void SplitRegionAround(int tileIndex, int regionId);
+
+    template <typename Visitor>
+    void ForEachNeighborTile(int tileIndex, Visitor const& visit) const;
+
+    IntVec2                       m_dimensions = IntVec2::ZERO;
+    std::vector<int>              m_regionIds;        // Per tile, NO_REGION for blocked tiles
+    std::vector<int>              m_tileSlots;        // Per open tile, its position in its region's list
+    std::vector<std::vector<int>> m_regionTiles;      // Per region id, empty for free ids
+    std::vector<int>              m_freeRegionIds;
+    TileConnectivity              m_connectivity;     // Build only
+
+    // Split scratch: one flood per open neighbor of the closed tile; floods that meet are unioned
+    static constexpr int MAX_SPLIT_FLOODS = 4;
+
+    uint32_t              m_visitStamp = 0;
+    std::vector<uint32_t> m_visitStamps;
+    std::vector<uint8_t>  m_visitFloods;
+    std::vector<int>      m_floodTiles[MAX_SPLIT_FLOODS];    // Visit order; doubles as the flood queue
+};
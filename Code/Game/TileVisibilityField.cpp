@@ -0,0 +1,136 @@
+//----------------------------------------------------------------------------------------------------
+// TileVisibilityField.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileVisibilityField.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Maps an octant's (column, row) offsets onto the map: tileX = colX * col + rowX * row, and likewise for y
+    struct OctantTransform
+    {
+        int m_colX;
+        int m_rowX;
+        int m_colY;
+        int m_rowY;
+    };
+
+    OctantTransform constexpr OCTANT_TRANSFORMS[8] =
+    {
+        { 1,  0,  0,  1},
+        { 0,  1,  1,  0},
+        { 0, -1,  1,  0},
+        {-1,  0,  0,  1},
+        {-1,  0,  0, -1},
+        { 0, -1, -1,  0},
+        { 0,  1, -1,  0},
+        { 1,  0,  0, -1},
+    };
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileVisibilityField::Compute(TileBitboard const& blockedBits, IntVec2 const& originCoords, int const radius)
+{
+    if (m_visibleBits.GetDimensions() != blockedBits.GetDimensions())
+    {
+        m_visibleBits.Resize(blockedBits.GetDimensions());
+    }
+    else
+    {
+        m_visibleBits.ClearAll();
+    }
+
+    m_blockedBits  = &blockedBits;
+    m_originCoords = originCoords;
+    m_radius       = radius;
+
+    if (IsInMap(originCoords.x, originCoords.y)) m_visibleBits.Set(originCoords.x, originCoords.y);
+
+    for (int octant = 0; octant < 8; ++octant)
+    {
+        CastOctant(octant, 1, 1.f, 0.f);
+    }
+
+    m_blockedBits = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// False past the radius the field was computed for, so callers must stay within it
+bool TileVisibilityField::IsVisible(IntVec2 const& tileCoords) const
+{
+    if (!IsInMap(tileCoords.x, tileCoords.y)) return false;
+
+    return m_visibleBits.IsSet(tileCoords.x, tileCoords.y);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Lights the part of the octant between startSlope and endSlope (column offset over row offset, from the
+// origin's center), starting at firstRow. A run of blocking tiles recurses for the slopes above it and
+// carries on below it; a row that ends inside such a run has nothing lit behind it.
+void TileVisibilityField::CastOctant(int const octant, int const firstRow, float startSlope, float const endSlope)
+{
+    if (startSlope < endSlope) return;
+
+    OctantTransform const& transform      = OCTANT_TRANSFORMS[octant];
+    float                  nextStartSlope = startSlope;
+
+    for (int row = firstRow; row <= m_radius; ++row)
+    {
+        bool isInBlockedRun = false;
+
+        for (int col = row; col >= 0; --col)
+        {
+            float const upperSlope = (static_cast<float>(col) + 0.5f) / (static_cast<float>(row) - 0.5f);
+            float const lowerSlope = (static_cast<float>(col) - 0.5f) / (static_cast<float>(row) + 0.5f);
+
+            if (lowerSlope > startSlope) continue;
+            if (upperSlope < endSlope) break;
+
+            int const  tileX      = m_originCoords.x + transform.m_colX * col + transform.m_rowX * row;
+            int const  tileY      = m_originCoords.y + transform.m_colY * col + transform.m_rowY * row;
+            bool const isBlocking = IsBlocking(tileX, tileY);
+
+            float const centerSlope = static_cast<float>(col) / static_cast<float>(row);
+
+            if (centerSlope <= startSlope && centerSlope >= endSlope && IsInMap(tileX, tileY)) m_visibleBits.Set(tileX, tileY);
+
+            if (isInBlockedRun)
+            {
+                if (isBlocking)
+                {
+                    nextStartSlope = lowerSlope;
+                    continue;
+                }
+
+                isInBlockedRun = false;
+                startSlope     = nextStartSlope;
+            }
+            else if (isBlocking && row < m_radius)
+            {
+                isInBlockedRun = true;
+                CastOctant(octant, row + 1, startSlope, upperSlope);
+                nextStartSlope = lowerSlope;
+            }
+        }
+
+        if (isInBlockedRun) return;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileVisibilityField::IsBlocking(int const tileX, int const tileY) const
+{
+    if (!IsInMap(tileX, tileY)) return true;
+
+    return m_blockedBits->IsSet(tileX, tileY);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileVisibilityField::IsInMap(int const tileX, int const tileY) const
+{
+    IntVec2 const dimensions = m_visibleBits.GetDimensions();
+
+    return tileX >= 0 && tileY >= 0 && tileX < dimensions.x && tileY < dimensions.y;
+}
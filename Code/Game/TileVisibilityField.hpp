@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------------------------------
+// TileVisibilityField.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Which tiles can be seen from the center of one origin tile, out to a square radius, by recursive
+// shadowcasting: each of the eight octants is scanned row by row, and a run of blocking tiles narrows the
+// lit slope range for the rows behind it. A tile counts as visible if its center is lit, so the field
+// never claims less than a ray from center to center would see. Tiles off the map block. Cost follows
+// the lit area, so one field answers every query toward the origin.
+//
+class TileVisibilityField
+{
+public:
+    void Compute(TileBitboard const& blockedBits, IntVec2 const& originCoords, int radius);
+    bool IsComputed() const { return m_radius >= 0; }
+    bool IsVisible(IntVec2 const& tileCoords) const;
+
+    IntVec2 GetOriginCoords() const { return m_originCoords; }
+    int     GetRadius() const { return m_radius; }
+
+private:
+    void CastOctant(int octant, int firstRow, float startSlope, float endSlope);
+    bool IsBlocking(int tileX, int tileY) const;
+    bool IsInMap(int tileX, int tileY) const;
+
+    TileBitboard const* m_blockedBits  = nullptr;    // Only during Compute
+    TileBitboard        m_visibleBits;
+    IntVec2             m_originCoords = IntVec2::ZERO;
+    int                 m_radius       = -1;
+};
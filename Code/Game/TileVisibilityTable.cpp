@@ -0,0 +1,273 @@
+//----------------------------------------------------------------------------------------------------
+// TileVisibilityTable.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/TileVisibilityTable.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    enum HullState : uint8_t
+    {
+        HULL_STATE_OUTSIDE,
+        HULL_STATE_OPEN,
+        HULL_STATE_BLOCKED,
+        HULL_STATE_REACHED
+    };
+
+    //----------------------------------------------------------------------------------------------------
+    // Narrows [minT, maxT] to where the segment from 0 to delta (along one axis) is strictly within 1 of
+    // boxCenter. A tile reaches into the convex hull of the two tiles at the segment's ends exactly when the
+    // segment between their centers passes through the open 2x2 box around it, i.e. both axes leave a
+    // non-empty range. The parameter runs from 0 to a scale that both nonzero delta components divide,
+    // tPerUnit being scale / delta (0 where delta is 0), so every bound is a whole number and touching
+    // counts as missing exactly.
+    void NarrowToOpenSlab(int const boxCenter, int const tPerUnit, int& minT, int& maxT)
+    {
+        if (tPerUnit == 0)
+        {
+            if (boxCenter != 0) maxT = minT;
+            return;
+        }
+
+        int const entryT = (boxCenter - 1) * tPerUnit;
+        int const exitT  = (boxCenter + 1) * tPerUnit;
+
+        minT = std::max(minT, std::min(entryT, exitT));
+        maxT = std::min(maxT, std::max(entryT, exitT));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC size_t TileVisibilityTable::GetNumWords(IntVec2 const& dimensions, int const radius)
+{
+    int const windowWidth = 2 * radius + 1;
+    int const wordsPerSet = (windowWidth * windowWidth + 63) / 64;
+
+    return static_cast<size_t>(dimensions.x) * dimensions.y * 2 * wordsPerSet;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool TileVisibilityTable::IsWithinBudget(IntVec2 const& dimensions, int const radius)
+{
+    // 64-bit so a huge map can't wrap past the cap on Win32
+    uint64_t const windowWidth = static_cast<uint64_t>(2 * radius + 1);
+
+    return static_cast<uint64_t>(dimensions.x) * dimensions.y * windowWidth * windowWidth <= MAX_PAIRS;
+}
+
+//----------------------------------------------------------------------------------------------------
+// False (and no table) if the map and radius are past MAX_PAIRS
+bool TileVisibilityTable::Build(TileBitboard const& blockedBits, int const radius)
+{
+    IntVec2 const dimensions = blockedBits.GetDimensions();
+
+    Clear();
+
+    if (radius <= 0 || !IsWithinBudget(dimensions, radius)) return false;
+
+    m_blockedBits = blockedBits;
+    m_radius      = radius;
+    m_windowWidth = 2 * radius + 1;
+    m_wordsPerSet = (m_windowWidth * m_windowWidth + 63) / 64;
+    m_words.assign(GetNumWords(dimensions, radius), 0);
+
+    for (int tileY = 0; tileY < dimensions.y; ++tileY)
+    {
+        for (int tileX = 0; tileX < dimensions.x; ++tileX)
+        {
+            IntVec2 const fromCoords = IntVec2(tileX, tileY);
+            int const     tileIndex  = tileY * dimensions.x + tileX;
+
+            for (int offsetY = -radius; offsetY <= radius; ++offsetY)
+            {
+                for (int offsetX = -radius; offsetX <= radius; ++offsetX)
+                {
+                    IntVec2 const toCoords = IntVec2(tileX + offsetX, tileY + offsetY);
+
+                    if (toCoords.x < 0 || toCoords.y < 0 || toCoords.x >= dimensions.x || toCoords.y >= dimensions.y) continue;
+
+                    int const toTileIndex = toCoords.y * dimensions.x + toCoords.x;
+                    int const slot        = GetWindowSlot(IntVec2(offsetX, offsetY));
+
+                    // Earlier tiles already classified the pair from the other end
+                    TileVisibility const visibility = toTileIndex < tileIndex ? GetVisibility(toCoords, fromCoords) : ClassifyPair(fromCoords, toCoords);
+
+                    SetVisibility(tileIndex, slot, visibility);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Takes a table saved for these exact blockedBits; false (and no table) if the size doesn't fit. The bytes
+// need not be aligned, so they can come straight out of a mapped snapshot.
+bool TileVisibilityTable::Load(TileBitboard const& blockedBits, int const radius, unsigned char const* wordBytes, size_t const numWords)
+{
+    Clear();
+
+    if (radius <= 0 || !IsWithinBudget(blockedBits.GetDimensions(), radius)) return false;
+    if (numWords != GetNumWords(blockedBits.GetDimensions(), radius)) return false;
+
+    m_blockedBits = blockedBits;
+    m_radius      = radius;
+    m_windowWidth = 2 * radius + 1;
+    m_wordsPerSet = (m_windowWidth * m_windowWidth + 63) / 64;
+    m_words.resize(numWords);
+    memcpy(m_words.data(), wordBytes, numWords * sizeof(uint64_t));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileVisibilityTable::Clear()
+{
+    m_radius      = 0;
+    m_windowWidth = 0;
+    m_wordsPerSet = 0;
+    m_words.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TileVisibilityTable::IsBuiltOver(TileBitboard const& blockedBits) const
+{
+    if (!IsBuilt() || m_blockedBits.GetDimensions() != blockedBits.GetDimensions()) return false;
+
+    int const wordsPerRow = blockedBits.GetWordsPerRow();
+
+    for (int tileY = 0; tileY < blockedBits.GetDimensions().y; ++tileY)
+    {
+        if (memcmp(m_blockedBits.GetRow(tileY), blockedBits.GetRow(tileY), wordsPerRow * sizeof(uint64_t)) != 0) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+TileVisibility TileVisibilityTable::GetVisibility(IntVec2 const& fromCoords, IntVec2 const& toCoords) const
+{
+    if (!IsBuilt()) return TILE_VISIBILITY_UNKNOWN;
+
+    IntVec2 const dimensions = m_blockedBits.GetDimensions();
+    IntVec2 const offset     = toCoords - fromCoords;
+
+    if (fromCoords.x < 0 || fromCoords.y < 0 || fromCoords.x >= dimensions.x || fromCoords.y >= dimensions.y) return TILE_VISIBILITY_UNKNOWN;
+    if (abs(offset.x) > m_radius || abs(offset.y) > m_radius) return TILE_VISIBILITY_UNKNOWN;
+    if (toCoords.x < 0 || toCoords.y < 0 || toCoords.x >= dimensions.x || toCoords.y >= dimensions.y) return TILE_VISIBILITY_UNKNOWN;
+
+    int const       slot       = GetWindowSlot(offset);
+    size_t const    firstWord  = static_cast<size_t>(fromCoords.y * dimensions.x + fromCoords.x) * 2 * m_wordsPerSet;
+    uint64_t const  slotBit    = 1ull << (slot & 63);
+    uint64_t const* clearBits  = &m_words[firstWord];
+    uint64_t const* hiddenBits = clearBits + m_wordsPerSet;
+
+    if ((clearBits[slot >> 6] & slotBit) != 0) return TILE_VISIBILITY_CLEAR;
+    if ((hiddenBits[slot >> 6] & slotBit) != 0) return TILE_VISIBILITY_HIDDEN;
+
+    return TILE_VISIBILITY_PARTIAL;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A ray starting in or ending in a blocking tile always impacts, so such pairs are hidden outright
+TileVisibility TileVisibilityTable::ClassifyPair(IntVec2 const& fromCoords, IntVec2 const& toCoords)
+{
+    if (IsBlocked(fromCoords.x, fromCoords.y) || IsBlocked(toCoords.x, toCoords.y)) return TILE_VISIBILITY_HIDDEN;
+
+    IntVec2 const delta    = toCoords - fromCoords;
+    IntVec2 const mins     = IntVec2(std::min(fromCoords.x, toCoords.x), std::min(fromCoords.y, toCoords.y));
+    int const     width    = abs(delta.x) + 1;
+    int const     height   = abs(delta.y) + 1;
+    int const     scale    = std::max(abs(delta.x), 1) * std::max(abs(delta.y), 1);
+    IntVec2 const tPerUnit = IntVec2(delta.x != 0 ? scale / delta.x : 0, delta.y != 0 ? scale / delta.y : 0);
+    bool          isClear  = true;
+
+    m_hullStates.assign(static_cast<size_t>(width) * height, HULL_STATE_OUTSIDE);
+
+    for (int boxY = 0; boxY < height; ++boxY)
+    {
+        int rowMinT = 0;
+        int rowMaxT = scale;
+
+        NarrowToOpenSlab(mins.y + boxY - fromCoords.y, tPerUnit.y, rowMinT, rowMaxT);
+
+        if (rowMinT >= rowMaxT) continue;
+
+        for (int boxX = 0; boxX < width; ++boxX)
+        {
+            int minT = rowMinT;
+            int maxT = rowMaxT;
+
+            NarrowToOpenSlab(mins.x + boxX - fromCoords.x, tPerUnit.x, minT, maxT);
+
+            if (minT >= maxT) continue;
+
+            bool const isBlocked = IsBlocked(mins.x + boxX, mins.y + boxY);
+
+            m_hullStates[boxY * width + boxX] = isBlocked ? HULL_STATE_BLOCKED : HULL_STATE_OPEN;
+
+            if (isBlocked) isClear = false;
+        }
+    }
+
+    if (isClear) return TILE_VISIBILITY_CLEAR;
+
+    // Flood the open hull tiles from fromCoords; every segment to toCoords would have to follow them
+    int const fromBoxIndex = (fromCoords.y - mins.y) * width + (fromCoords.x - mins.x);
+    int const toBoxIndex   = (toCoords.y - mins.y) * width + (toCoords.x - mins.x);
+
+    m_hullOpenStack.clear();
+    m_hullOpenStack.push_back(fromBoxIndex);
+    m_hullStates[fromBoxIndex] = HULL_STATE_REACHED;
+
+    while (!m_hullOpenStack.empty())
+    {
+        int const boxIndex = m_hullOpenStack.back();
+        int const boxX     = boxIndex % width;
+        int const boxY     = boxIndex / width;
+
+        m_hullOpenStack.pop_back();
+
+        if (boxIndex == toBoxIndex) return TILE_VISIBILITY_PARTIAL;
+
+        for (int neighborY = std::max(boxY - 1, 0); neighborY <= std::min(boxY + 1, height - 1); ++neighborY)
+        {
+            for (int neighborX = std::max(boxX - 1, 0); neighborX <= std::min(boxX + 1, width - 1); ++neighborX)
+            {
+                int const neighborIndex = neighborY * width + neighborX;
+
+                if (m_hullStates[neighborIndex] != HULL_STATE_OPEN) continue;
+
+                m_hullStates[neighborIndex] = HULL_STATE_REACHED;
+                m_hullOpenStack.push_back(neighborIndex);
+            }
+        }
+    }
+
+    return TILE_VISIBILITY_HIDDEN;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TileVisibilityTable::SetVisibility(int const tileIndex, int const slot, TileVisibility const visibility)
+{
+    size_t const   firstWord = static_cast<size_t>(tileIndex) * 2 * m_wordsPerSet;
+    uint64_t const slotBit   = 1ull << (slot & 63);
+
+    if (visibility == TILE_VISIBILITY_CLEAR) m_words[firstWord + (slot >> 6)] |= slotBit;
+    if (visibility == TILE_VISIBILITY_HIDDEN) m_words[firstWord + m_wordsPerSet + (slot >> 6)] |= slotBit;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TileVisibilityTable::GetWindowSlot(IntVec2 const& offset) const
+{
+    return (offset.y + m_radius) * m_windowWidth + (offset.x + m_radius);
+}
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------------------------------
+// TileVisibilityTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/TileBitboard.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum TileVisibility : uint8_t
+{
+    TILE_VISIBILITY_UNKNOWN,    // No table, or the pair is further apart than its radius
+    TILE_VISIBILITY_HIDDEN,     // No segment from the one tile to the other is clear
+    TILE_VISIBILITY_PARTIAL,    // Depends on where in the tiles the segment runs; trace a ray
+    TILE_VISIBILITY_CLEAR       // Every segment from the one tile to the other is clear
+};
+
+//----------------------------------------------------------------------------------------------------
+// Potentially visible set for static terrain: for every tile, two bitsets (clear, hidden) over the
+// square window of tiles within the radius, so a pair lookup is two bit reads. Both are conservative
+// in the same way a precise ray would be: segments between two tiles stay inside the convex hull of
+// the pair, so the pair is clear if no blocking tile reaches into that hull, and hidden if the open
+// hull tiles don't connect the two (8-connected, so a segment can't slip between them).
+// Visibility is symmetric, so each pair is derived once.
+//
+// Storage is a flat two bits per pair and the build classifies every pair, so this is for small maps
+// only: Build and Load refuse anything past MAX_PAIRS.
+//
+class TileVisibilityTable
+{
+public:
+    bool Build(TileBitboard const& blockedBits, int radius);
+    bool Load(TileBitboard const& blockedBits, int radius, unsigned char const* wordBytes, size_t numWords);
+    void Clear();
+
+    bool IsBuilt() const { return m_radius > 0; }
+    bool IsBuiltOver(TileBitboard const& blockedBits) const;
+    int  GetRadius() const { return m_radius; }
+
+    TileVisibility               GetVisibility(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
+    std::vector<uint64_t> const& GetWords() const { return m_words; }
+
+    static size_t GetNumWords(IntVec2 const& dimensions, int radius);
+    static bool   IsWithinBudget(IntVec2 const& dimensions, int radius);
+
+    // Tiles times window slots; about 1 MB of bits and a few hundred milliseconds of build
+    static constexpr size_t MAX_PAIRS = static_cast<size_t>(1) << 22;
+
+private:
+    TileVisibility ClassifyPair(IntVec2 const& fromCoords, IntVec2 const& toCoords);
+    void           SetVisibility(int tileIndex, int slot, TileVisibility visibility);
+    int            GetWindowSlot(IntVec2 const& offset) const;
+    bool           IsBlocked(int tileX, int tileY) const { return m_blockedBits.IsSet(tileX, tileY); }
+
+    TileBitboard          m_blockedBits;    // What the table was built over
+    int                   m_radius       = 0;
+    int                   m_windowWidth  = 0;    // 2 * m_radius + 1
+    int                   m_wordsPerSet  = 0;
+    std::vector<uint64_t> m_words;               // Per tile: clear bits, then hidden bits, one per window slot
+
+    // ClassifyPair scratch over the pair's bounding box
+    std::vector<uint8_t> m_hullStates;
+    std::vector<int>     m_hullOpenStack;
+};